@@ -19,11 +19,23 @@
 #include "benchmark.h"
 #include "numa.h"
 
+#include <cctype>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <vector>
 
+#include "misc.h"
+#include "movegen.h"
+#include "position.h"
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
 namespace {
 
 // clang-format off
@@ -437,6 +449,186 @@ std::vector<std::string> setup_bench(const std::string& currentFen, std::istream
     return list;
 }
 
+// Builds a list of UCI commands to be run by perftbench, analogous to
+// setup_bench but over a fixed suite of movegen-heavy positions with known
+// node counts, so successive commits get a reproducible movegen-throughput
+// number. There are three parameters: number of threads to split the root
+// moves over, the perft depth, and a file name where to look for positions
+// in FEN format. Examples:
+//
+// perftbench              : perft 6 on the builtin suite, all cores
+// perftbench 1 5          : single-threaded perft 5 on the builtin suite
+// perftbench 4 6 blah     : perft 6 with 4 threads on positions in file "blah"
+std::vector<std::string> setup_perft_bench(const std::string& currentFen, std::istream& is) {
+
+    static const std::vector<std::string> PerftDefaults = {
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+      "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+      "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+      "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+      "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+      "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    };
+
+    std::vector<std::string> fens, list;
+    std::string              token;
+
+    std::string threads = (is >> token) ? token : std::to_string(get_hardware_concurrency());
+    std::string depth   = (is >> token) ? token : "6";
+    std::string fenFile = (is >> token) ? token : "default";
+
+    if (fenFile == "default")
+        fens = PerftDefaults;
+
+    else if (fenFile == "current")
+        fens.push_back(currentFen);
+
+    else
+    {
+        std::string   fen;
+        std::ifstream file(fenFile);
+
+        if (!file.is_open())
+        {
+            std::cerr << "Unable to open file " << fenFile << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        while (getline(file, fen))
+            if (!fen.empty())
+                fens.push_back(fen);
+
+        file.close();
+    }
+
+    list.emplace_back("setoption name Threads value " + threads);
+
+    for (const std::string& fen : fens)
+    {
+        list.emplace_back("position fen " + fen);
+        list.emplace_back("go perft " + depth);
+    }
+
+    return list;
+}
+
+namespace {
+
+// Splits a mapped EPD/FEN byte range into per-record FEN strings, keeping
+// only the first four fields of each record and defaulting the counters.
+std::vector<std::string> parse_epd(const char* data, size_t size) {
+
+    std::vector<std::string> fens;
+
+    size_t pos = 0;
+    while (pos < size)
+    {
+        size_t eol = pos;
+        while (eol < size && data[eol] != '\n')
+            ++eol;
+
+        std::string fen;
+        int         fields = 0;
+        for (size_t p = pos; fields < 4 && p < eol;)
+        {
+            while (p < eol && std::isspace(static_cast<unsigned char>(data[p])))
+                ++p;
+            size_t begin = p;
+            while (p < eol && !std::isspace(static_cast<unsigned char>(data[p])))
+                ++p;
+            if (p > begin)
+            {
+                fen.append(data + begin, p - begin).append(1, ' ');
+                ++fields;
+            }
+        }
+
+        if (fields == 4)
+            fens.push_back(fen + "0 1");
+
+        pos = eol + 1;
+    }
+
+    return fens;
+}
+
+}  // namespace
+
+std::vector<std::string> read_epd_corpus(const std::string& path) {
+
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        std::cerr << "Unable to open file " << path << std::endl;
+        return {};
+    }
+
+    struct stat sb;
+    if (fstat(fd, &sb) != 0 || sb.st_size == 0)
+    {
+        ::close(fd);
+        return {};
+    }
+
+    void* map = mmap(nullptr, size_t(sb.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED)
+    {
+        std::cerr << "Unable to map file " << path << std::endl;
+        return {};
+    }
+
+    auto fens = parse_epd(static_cast<const char*>(map), size_t(sb.st_size));
+    munmap(map, size_t(sb.st_size));
+    return fens;
+#else
+    auto contents = read_file_to_string(path);
+    if (!contents)
+    {
+        std::cerr << "Unable to open file " << path << std::endl;
+        return {};
+    }
+    return parse_epd(contents->data(), contents->size());
+#endif
+}
+
+std::pair<std::uint64_t, std::uint64_t> see_bench() {
+
+    // Capture-heavy middlegame positions, so the exchange resolution loop in
+    // see_ge() runs deep enough to exercise the X-ray attacker updates.
+    static const std::vector<std::string> SeePositions = {
+      "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+      "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+      "4rrk1/pp1n3p/3q2pQ/2p1pb2/2PP4/2P3N1/P2B2PP/4RRK1 b - - 7 19",
+      "r1bq1r1k/1pp1n1pp/1p1p4/4p2Q/4Pp2/1BNP4/PPP2PPP/3R1RK1 w - - 2 14",
+      "3q2k1/pb3p1p/4pbp1/2r5/PpN2N2/1P2P2P/5PP1/Q2R2K1 b - - 4 26",
+      "2rqkb1r/ppp2p2/2npb1p1/1N1Nn2p/2P1PP2/8/PP2B1PP/R1BQK2R b KQ - 0 11",
+    };
+
+    static constexpr int Thresholds[] = {-400, -200, -100, -1, 0, 1, 100, 200, 400};
+    static constexpr int Rounds       = 20000;
+
+    std::uint64_t calls = 0, hits = 0;
+
+    for (const std::string& fen : SeePositions)
+    {
+        StateInfo st;
+        Position  pos;
+        pos.set(fen, false, &st);
+
+        for (int round = 0; round < Rounds; ++round)
+            for (const Move m : MoveList<CAPTURES>(pos))
+                for (int threshold : Thresholds)
+                {
+                    ++calls;
+                    hits += pos.see_ge(m, threshold);
+                }
+    }
+
+    return {calls, hits};
+}
+
 BenchmarkSetup setup_benchmark(std::istream& is) {
     // TT_SIZE_PER_THREAD is chosen such that roughly half of the hash is used all positions
     // for the current sequence have been searched.
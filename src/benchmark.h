@@ -19,14 +19,29 @@
 #ifndef BENCHMARK_H_INCLUDED
 #define BENCHMARK_H_INCLUDED
 
+#include <cstdint>
 #include <iosfwd>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Stockfish::Benchmark {
 
 std::vector<std::string> setup_bench(const std::string&, std::istream&);
 
+std::vector<std::string> setup_perft_bench(const std::string&, std::istream&);
+
+// Reads an EPD or FEN corpus for 'epdbench', memory-mapping the file on
+// POSIX systems instead of streaming it with getline. Each returned string
+// is the first four fields of one record, with defaulted move counters, so
+// both plain FEN files and EPD files with opcodes are accepted.
+std::vector<std::string> read_epd_corpus(const std::string& path);
+
+// Microbenchmark for the static exchange evaluation kernel. Returns the number
+// of see_ge() calls made and how many returned true; the latter doubles as a
+// checksum so functional regressions show up alongside throughput ones.
+std::pair<std::uint64_t, std::uint64_t> see_bench();
+
 struct BenchmarkSetup {
     int                      ttSize;
     int                      threads;
@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include <bitset>
+#include <chrono>
 #include <initializer_list>
 
 #include "misc.h"
@@ -36,12 +37,25 @@ Bitboard PawnAttacks[COLOR_NB][SQUARE_NB];
 
 alignas(64) Magic Magics[SQUARE_NB][2];
 
+#ifdef USE_AVX2
+Bitboard        SliderMasks[2][SQUARE_NB];
+Bitboard        SliderMagics[2][SQUARE_NB];
+Bitboard        SliderShifts[2][SQUARE_NB];
+Bitboard        SliderOffsets[2][SQUARE_NB];
+const Bitboard* SliderTable[2];
+#endif
+
+#ifdef USE_PEXT
+bool UsePext = true;
+#endif
+
 namespace {
 
 Bitboard RookTable[0x19000];   // To store rook attacks
 Bitboard BishopTable[0x1480];  // To store bishop attacks
 
-void init_magics(PieceType pt, Bitboard table[], Magic magics[][2]);
+void     init_magics(PieceType pt, Bitboard table[], Magic magics[][2]);
+Bitboard sliding_attack(PieceType pt, Square sq, Bitboard occupied);
 
 // Returns the bitboard of target square for the given step
 // from the given square. If the step is off the board, returns empty bitboard.
@@ -49,6 +63,54 @@ Bitboard safe_destination(Square s, int step) {
     Square to = Square(s + step);
     return is_ok(to) && distance(s, to) <= 2 ? square_bb(to) : Bitboard(0);
 }
+
+#ifdef USE_PEXT
+// Discards the benchmark results below in a way the optimizer cannot see through
+volatile Bitboard benchmarkSink;
+
+// Times a dependent chain of PEXT extractions over realistic rook masks
+// against the equivalent magic multiply sequence, and returns true if PEXT
+// is at least as fast. The latency of microcoded PEXT implementations grows
+// with the number of set mask bits, so real masks matter for the measurement.
+bool benchmark_pext_faster() {
+
+    Bitboard masks[SQUARE_NB];
+    for (Square s = SQ_A1; s <= SQ_H8; ++s)
+    {
+        Bitboard edges = ((Rank1BB | Rank8BB) & ~rank_bb(s)) | ((FileABB | FileHBB) & ~file_bb(s));
+        masks[s]       = sliding_attack(ROOK, s, 0) & ~edges;
+    }
+
+    constexpr int      Iterations = 1 << 16;
+    constexpr Bitboard MagicConst = 0x9D39247E33776D41ULL;  // Any sparse constant will do
+
+    auto timed = [&](auto op) {
+        int64_t best = INT64_MAX;
+
+        for (int run = 0; run < 3; ++run)
+        {
+            Bitboard occ   = 0xFFFF00000000FFFFULL;
+            auto     begin = std::chrono::steady_clock::now();
+
+            for (int i = 0; i < Iterations; ++i)
+                occ ^= op(occ, masks[i & 63]);
+
+            auto end      = std::chrono::steady_clock::now();
+            benchmarkSink = occ;
+
+            best = std::min(
+              best, std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+        }
+        return best;
+    };
+
+    int64_t pextTime = timed([](Bitboard occ, Bitboard mask) { return pext(occ, mask); });
+    int64_t magicTime =
+      timed([](Bitboard occ, Bitboard mask) { return ((occ & mask) * MagicConst) >> 52; });
+
+    return pextTime <= magicTime;
+}
+#endif
 }
 
 // Returns an ASCII representation of a bitboard suitable
@@ -81,9 +143,31 @@ void Bitboards::init() {
         for (Square s2 = SQ_A1; s2 <= SQ_H8; ++s2)
             SquareDistance[s1][s2] = std::max(distance<File>(s1, s2), distance<Rank>(s1, s2));
 
+#ifdef USE_PEXT
+    // Pick the faster indexing for this host before the tables are filled
+    UsePext = benchmark_pext_faster();
+#endif
+
     init_magics(ROOK, RookTable, Magics);
     init_magics(BISHOP, BishopTable, Magics);
 
+#ifdef USE_AVX2
+    // Mirror the magic data into the structure-of-arrays layout the batched
+    // lookups load from, with the attack pointers flattened to table offsets
+    SliderTable[BISHOP - BISHOP] = BishopTable;
+    SliderTable[ROOK - BISHOP]   = RookTable;
+
+    for (Square s = SQ_A1; s <= SQ_H8; ++s)
+        for (int t = 0; t < 2; ++t)
+        {
+            const Magic& m      = Magics[s][t];
+            SliderMasks[t][s]   = m.mask;
+            SliderMagics[t][s]  = m.magic;
+            SliderShifts[t][s]  = m.shift;
+            SliderOffsets[t][s] = Bitboard(m.attacks - SliderTable[t]);
+        }
+#endif
+
     for (Square s1 = SQ_A1; s1 <= SQ_H8; ++s1)
     {
         PawnAttacks[WHITE][s1] = pawn_attacks_bb<WHITE>(square_bb(s1));
@@ -143,14 +227,12 @@ Bitboard sliding_attack(PieceType pt, Square sq, Bitboard occupied) {
 // the so called "fancy" approach.
 void init_magics(PieceType pt, Bitboard table[], Magic magics[][2]) {
 
-#ifndef USE_PEXT
     // Optimal PRNG seeds to pick the correct magics in the shortest time
     int seeds[][RANK_NB] = {{8977, 44560, 54343, 38998, 5731, 95205, 104912, 17020},
                             {728, 10316, 55013, 32803, 12281, 15100, 16645, 255}};
 
     Bitboard occupancy[4096];
     int      epoch[4096] = {}, cnt = 0;
-#endif
     Bitboard reference[4096];
     int      size = 0;
 
@@ -166,9 +248,7 @@ void init_magics(PieceType pt, Bitboard table[], Magic magics[][2]) {
         // apply to the 64 or 32 bits word to get the index.
         Magic& m = magics[s][pt - BISHOP];
         m.mask   = sliding_attack(pt, s, 0) & ~edges;
-#ifndef USE_PEXT
-        m.shift = (Is64Bit ? 64 : 32) - popcount(m.mask);
-#endif
+        m.shift  = (Is64Bit ? 64 : 32) - popcount(m.mask);
         // Set the offset for the attacks table of the square. We have individual
         // table sizes for each square with "Fancy Magic Bitboards".
         m.attacks = s == SQ_A1 ? table : magics[s - 1][pt - BISHOP].attacks + size;
@@ -179,19 +259,21 @@ void init_magics(PieceType pt, Bitboard table[], Magic magics[][2]) {
         Bitboard b = 0;
         do
         {
-#ifndef USE_PEXT
             occupancy[size] = b;
-#endif
             reference[size] = sliding_attack(pt, s, b);
 
-            if (HasPext)
+            if (UsePext)
                 m.attacks[pext(b, m.mask)] = reference[size];
 
             size++;
             b = (b - m.mask) & m.mask;
         } while (b);
 
-#ifndef USE_PEXT
+        // Only the indexing selected at startup gets a consistent table, so
+        // with PEXT live there is no point searching for the magics.
+        if (UsePext)
+            continue;
+
         PRNG rng(seeds[Is64Bit][rank_of(s)]);
 
         // Find a magic for square 's' picking up an (almost) random number
@@ -220,7 +302,6 @@ void init_magics(PieceType pt, Bitboard table[], Magic magics[][2]) {
                     break;
             }
         }
-#endif
     }
 }
 }
@@ -27,6 +27,10 @@
 #include <cstdlib>
 #include <string>
 
+#ifdef USE_AVX2
+    #include <immintrin.h>
+#endif
+
 #include "types.h"
 
 namespace Stockfish {
@@ -65,28 +69,37 @@ extern Bitboard PseudoAttacks[PIECE_TYPE_NB][SQUARE_NB];
 extern Bitboard PawnAttacks[COLOR_NB][SQUARE_NB];
 
 
+#ifdef USE_PEXT
+// PEXT-enabled builds carry both the PEXT and the magic multiply indexing;
+// Bitboards::init() microbenchmarks them on the actual host and fills the
+// attack tables for the winner. Pre-Zen3 AMD parts execute PEXT in microcode,
+// an order of magnitude slower than the multiply it replaces, while newer
+// cores retire it in a cycle or two.
+extern bool UsePext;
+#else
+constexpr bool UsePext = false;
+#endif
+
 // Magic holds all magic bitboards relevant data for a single square
 struct Magic {
     Bitboard  mask;
     Bitboard* attacks;
-#ifndef USE_PEXT
-    Bitboard magic;
-    unsigned shift;
-#endif
+    Bitboard  magic;
+    unsigned  shift;
 
     // Compute the attack's index using the 'magic bitboards' approach
     unsigned index(Bitboard occupied) const {
 
 #ifdef USE_PEXT
-        return unsigned(pext(occupied, mask));
-#else
+        if (UsePext)
+            return unsigned(pext(occupied, mask));
+#endif
         if (Is64Bit)
             return unsigned(((occupied & mask) * magic) >> shift);
 
         unsigned lo = unsigned(occupied) & unsigned(mask);
         unsigned hi = unsigned(occupied >> 32) & unsigned(mask >> 32);
         return (lo * unsigned(magic) ^ hi * unsigned(magic >> 32)) >> shift;
-#endif
     }
 
     Bitboard attacks_bb(Bitboard occupied) const { return attacks[index(occupied)]; }
@@ -94,6 +107,17 @@ struct Magic {
 
 extern Magic Magics[SQUARE_NB][2];
 
+#ifdef USE_AVX2
+// Structure-of-arrays copies of the magic data plus the flat attack tables,
+// indexed by Pt - BISHOP and set up by Bitboards::init() for the vectorized
+// batch lookups at the bottom of this header
+extern Bitboard        SliderMasks[2][SQUARE_NB];
+extern Bitboard        SliderMagics[2][SQUARE_NB];
+extern Bitboard        SliderShifts[2][SQUARE_NB];
+extern Bitboard        SliderOffsets[2][SQUARE_NB];
+extern const Bitboard* SliderTable[2];
+#endif
+
 constexpr Bitboard square_bb(Square s) {
     assert(is_ok(s));
     return (1ULL << s);
@@ -369,6 +393,87 @@ inline Square pop_lsb(Bitboard& b) {
     return s;
 }
 
+
+// Batched attack queries: the attack sets of all pieces in 'sources' against
+// a single occupancy, computed in one pass. On AVX2 hosts the magic multiply,
+// shift and offset for four squares run vectorized, with one gather for the
+// data-dependent attack loads; batches too small to amortize the vector
+// setup, PEXT hosts (whose scalar extraction is faster than the emulated
+// 64-bit multiply) and queens (two table lookups per square) use the
+// ordinary per-square lookups.
+struct AttackBatch {
+    int      size;
+    Square   from[16];
+    Bitboard attacks[16];
+};
+
+#ifdef USE_AVX2
+
+// Four magic lookups at once. AVX2 has no 64x64->64 multiply, so it is
+// emulated with three 32-bit ones; the variable shift and the gather on the
+// flat attack table are native.
+template<PieceType Pt>
+inline void attacks_bb_batch4(const Square* from, Bitboard occupied, Bitboard* out) {
+
+    static_assert(Pt == BISHOP || Pt == ROOK, "Unsupported piece type in attacks_bb_batch4()");
+    constexpr int T = Pt - BISHOP;
+
+    auto load4 = [&from](const Bitboard* table) {
+        return _mm256_setr_epi64x(table[from[0]], table[from[1]], table[from[2]], table[from[3]]);
+    };
+
+    const __m256i mask  = load4(SliderMasks[T]);
+    const __m256i magic = load4(SliderMagics[T]);
+    const __m256i shift = load4(SliderShifts[T]);
+    const __m256i base  = load4(SliderOffsets[T]);
+
+    const __m256i occ = _mm256_and_si256(_mm256_set1_epi64x(occupied), mask);
+
+    const __m256i swapped = _mm256_shuffle_epi32(magic, 0xB1);
+    const __m256i crossed = _mm256_mullo_epi32(occ, swapped);
+    const __m256i summed  = _mm256_add_epi32(crossed, _mm256_srli_epi64(crossed, 32));
+    const __m256i product =
+      _mm256_add_epi64(_mm256_mul_epu32(occ, magic), _mm256_slli_epi64(summed, 32));
+
+    const __m256i index = _mm256_add_epi64(_mm256_srlv_epi64(product, shift), base);
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+                        _mm256_i64gather_epi64(reinterpret_cast<const long long*>(SliderTable[T]),
+                                               index, 8));
+}
+
+#endif
+
+template<PieceType Pt>
+inline void attacks_bb_batch(Bitboard sources, Bitboard occupied, AttackBatch& batch) {
+
+    static_assert(Pt == BISHOP || Pt == ROOK || Pt == QUEEN,
+                  "Unsupported piece type in attacks_bb_batch()");
+
+    int n = 0;
+    while (sources)
+        batch.from[n++] = pop_lsb(sources);
+    batch.size = n;
+
+#ifdef USE_AVX2
+    if constexpr (Pt != QUEEN)
+        if (!UsePext && n > 2)
+        {
+            // Pad the tail lanes with the last square, duplicates are cheap
+            for (int i = n; i < ((n + 3) & ~3); ++i)
+                batch.from[i] = batch.from[n - 1];
+
+            for (int i = 0; i < n; i += 4)
+                attacks_bb_batch4<Pt>(batch.from + i, occupied, batch.attacks + i);
+
+            return;
+        }
+#endif
+
+    for (int i = 0; i < n; ++i)
+        batch.attacks[i] = attacks_bb<Pt>(batch.from[i], occupied);
+}
+
 }  // namespace Stockfish
 
 #endif  // #ifndef BITBOARD_H_INCLUDED
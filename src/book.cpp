@@ -0,0 +1,185 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2025 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "book.h"
+
+#include <algorithm>
+#include <fstream>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "movegen.h"
+#include "position.h"
+
+// The on-disk format is polyglot's: records of {uint64 key, uint16 move,
+// uint16 weight, uint32 learn}, big-endian, sorted by key, with moves packed
+// as from/to file and rank plus a promotion code and castling written as
+// "king takes own rook". The keys however are Position::key(), reusing the
+// Zobrist tables initialized in Position::init(), not the fixed Random64
+// constants of classic PolyGlot. Existing books therefore need a one-time
+// conversion with this engine's keys; in exchange, probing needs no second
+// hashing scheme and stays consistent with every other key user (TT,
+// repetition detection, tracing).
+
+namespace Stockfish {
+
+namespace {
+
+constexpr size_t EntrySize = 16;
+
+uint64_t read_be64(const unsigned char* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i)
+        v = (v << 8) | p[i];
+    return v;
+}
+
+uint16_t read_be16(const unsigned char* p) { return uint16_t((p[0] << 8) | p[1]); }
+
+// Matches a packed book move against the legal moves of the position,
+// returning Move::none() if it is not playable. Castling is accepted both in
+// polyglot style (king to its own rook, which is also this engine's internal
+// encoding) and as the two-square king move.
+Move decode_move(uint16_t packed, const Position& pos) {
+
+    Square   to    = make_square(File(packed & 7), Rank((packed >> 3) & 7));
+    Square   from  = make_square(File((packed >> 6) & 7), Rank((packed >> 9) & 7));
+    int      promo = (packed >> 12) & 7;
+
+    for (const auto& m : MoveList<LEGAL>(pos))
+    {
+        if (m.from_sq() != from)
+            continue;
+
+        if (m.type_of() == CASTLING)
+        {
+            Square kingTo = make_square(m.to_sq() > from ? FILE_G : FILE_C, rank_of(from));
+            if (m.to_sq() != to && kingTo != to)
+                continue;
+        }
+        else if (m.to_sq() != to)
+            continue;
+
+        if (promo ? m.type_of() != PROMOTION || m.promotion_type() != PieceType(KNIGHT + promo - 1)
+                  : m.type_of() == PROMOTION)
+            continue;
+
+        return m;
+    }
+
+    return Move::none();
+}
+
+}  // namespace
+
+bool PolyglotBook::open(const std::string& file) {
+
+    close();
+
+#ifndef _WIN32
+    int fd = ::open(file.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat sb;
+    if (fstat(fd, &sb) != 0 || sb.st_size < off_t(EntrySize))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* map = mmap(nullptr, size_t(sb.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED)
+        return false;
+
+    mapSize    = size_t(sb.st_size);
+    entries    = static_cast<const unsigned char*>(map);
+    entryCount = mapSize / EntrySize;
+#else
+    std::ifstream in(file, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    if (!in || contents.size() < EntrySize)
+    {
+        contents.clear();
+        return false;
+    }
+
+    entries    = contents.data();
+    entryCount = contents.size() / EntrySize;
+#endif
+
+    return true;
+}
+
+void PolyglotBook::close() {
+
+#ifndef _WIN32
+    if (mapSize)
+        munmap(const_cast<unsigned char*>(entries), mapSize);
+#endif
+
+    contents.clear();
+    contents.shrink_to_fit();
+    entries    = nullptr;
+    entryCount = 0;
+    mapSize    = 0;
+}
+
+std::vector<std::pair<Move, int>> PolyglotBook::probe(const Position& pos) const {
+
+    std::vector<std::pair<Move, int>> moves;
+
+    if (!entryCount)
+        return moves;
+
+    const uint64_t key = pos.key();
+
+    // Binary search for the first record with this key
+    size_t lo = 0, hi = entryCount;
+    while (lo < hi)
+    {
+        size_t mid = (lo + hi) / 2;
+        if (read_be64(entries + mid * EntrySize) < key)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    for (; lo < entryCount; ++lo)
+    {
+        const unsigned char* e = entries + lo * EntrySize;
+        if (read_be64(e) != key)
+            break;
+
+        if (Move m = decode_move(read_be16(e + 8), pos); m != Move::none())
+            moves.emplace_back(m, int(read_be16(e + 10)));
+    }
+
+    std::stable_sort(moves.begin(), moves.end(),
+                     [](const auto& a, const auto& b) { return a.second > b.second; });
+
+    return moves;
+}
+
+}  // namespace Stockfish
@@ -0,0 +1,67 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2025 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BOOK_H_INCLUDED
+#define BOOK_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "types.h"
+
+namespace Stockfish {
+
+class Position;
+
+// Opening book in the polyglot on-disk format: 16-byte big-endian records
+// {key, move, weight, learn} sorted by key, probed with binary search over a
+// read-only memory mapping. Keys are this engine's Position::key(), so books
+// must be built with the same Zobrist tables; classic PolyGlot files use a
+// different fixed key set (see the doc comment in book.cpp). Probing is set
+// up with the 'Book File' option and happens in Engine::go() before any
+// search thread is woken.
+class PolyglotBook {
+   public:
+    ~PolyglotBook() { close(); }
+
+    PolyglotBook()                               = default;
+    PolyglotBook(const PolyglotBook&)            = delete;
+    PolyglotBook& operator=(const PolyglotBook&) = delete;
+
+    bool open(const std::string& file);
+    void close();
+    bool is_open() const { return entryCount != 0; }
+
+    // All legal book moves for the position with their weights, sorted by
+    // descending weight. Empty if the position is not in the book.
+    std::vector<std::pair<Move, int>> probe(const Position& pos) const;
+
+   private:
+    const unsigned char* entries    = nullptr;
+    size_t               entryCount = 0;
+
+    size_t                     mapSize = 0;  // Nonzero while 'entries' is a mapping
+    std::vector<unsigned char> contents;     // Used where mmap is unavailable
+};
+
+}  // namespace Stockfish
+
+#endif  // #ifndef BOOK_H_INCLUDED
@@ -20,6 +20,7 @@
 
 #include <cassert>
 #include <deque>
+#include <fstream>
 #include <iosfwd>
 #include <memory>
 #include <ostream>
@@ -36,6 +37,7 @@
 #include "position.h"
 #include "search.h"
 #include "syzygy/tbprobe.h"
+#include "tune.h"
 #include "types.h"
 #include "uci.h"
 #include "ucioption.h"
@@ -47,16 +49,21 @@ namespace NN = Eval::NNUE;
 constexpr auto StartFEN  = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
 constexpr int  MaxHashMB = Is64Bit ? 33554432 : 2048;
 
-Engine::Engine(std::optional<std::string> path) :
+Engine::Engine(std::optional<std::string> path, LazyNumaReplicated<NN::Networks>* sharedNetworks) :
     binaryDirectory(path ? CommandLine::get_binary_directory(*path) : ""),
     numaContext(NumaConfig::from_system()),
     states(new std::deque<StateInfo>(1)),
     threads(),
-    networks(
-      numaContext,
-      NN::Networks(
-        NN::NetworkBig({EvalFileDefaultNameBig, "None", ""}, NN::EmbeddedNNUEType::BIG),
-        NN::NetworkSmall({EvalFileDefaultNameSmall, "None", ""}, NN::EmbeddedNNUEType::SMALL))) {
+    ownedNetworks(
+      sharedNetworks
+        ? nullptr
+        : std::make_unique<LazyNumaReplicated<NN::Networks>>(
+            numaContext,
+            NN::Networks(
+              NN::NetworkBig({EvalFileDefaultNameBig, "None", ""}, NN::EmbeddedNNUEType::BIG),
+              NN::NetworkSmall({EvalFileDefaultNameSmall, "None", ""},
+                               NN::EmbeddedNNUEType::SMALL)))),
+    networks(sharedNetworks ? *sharedNetworks : *ownedNetworks) {
     pos.set(StartFEN, false, &states->back());
 
     options["Debug Log File"] << Option("", [](const Option& o) {
@@ -80,25 +87,113 @@ Engine::Engine(std::optional<std::string> path) :
         return std::nullopt;
     });
 
+    options["L1 Hash"] << Option(0, 0, 64, [this](const Option& o) {
+        wait_for_search_finished();
+        threads.set_tt_cache_size(size_t(int(o)));
+        return std::nullopt;
+    });
+
+    options["QSearch Cache"] << Option(false, [this](const Option& o) {
+        wait_for_search_finished();
+        threads.set_qsearch_cache(bool(int(o)));
+        return std::nullopt;
+    });
+
+    options["Eval Cache"] << Option(16, 0, 1024, [this](const Option& o) {
+        wait_for_search_finished();
+        evalCache.resize(size_t(int(o)));
+        return std::nullopt;
+    });
+
+    options["Trace Nodes"] << Option(0, 0, 1024, [this](const Option& o) {
+        wait_for_search_finished();
+        threads.set_node_trace_size(size_t(int(o)));
+        return std::nullopt;
+    });
+
+    options["NUMA TT Layout"]
+      << Option("Flat var Flat var Interleaved var Partitioned", "Flat", [this](const Option& o) {
+             set_tt_layout(o);
+             return std::nullopt;
+         });
+
+    options["Shared Hash Name"] << Option("", [this](const Option& o) {
+        wait_for_search_finished();
+        tt.set_shared_name(std::string(o) == "<empty>" ? "" : std::string(o));
+        set_tt_size(options["Hash"]);
+        return std::nullopt;
+    });
+
     options["Clear Hash"] << Option([this](const Option&) {
         search_clear();
         return std::nullopt;
     });
     options["Ponder"] << Option(false);
+    options["Speculative Warmup"] << Option(false);
+    options["Root Work Sharing"] << Option(false);
+    // Reproducible search for regression bisection: only the main thread
+    // searches, so 'go nodes N' from an equal hash state always replays the
+    // same tree regardless of the Threads setting.
+    options["Deterministic"] << Option(false);
+    options["Report Time Signals"] << Option(false);
+    options["Latency Stats"] << Option(false, [](const Option& o) {
+        latency_enable(o);
+        return std::nullopt;
+    });
+    options["Shared Finny Tables"] << Option(false, [this](const Option& o) {
+        threads.wait_for_search_finished();
+        threads.setup_shared_refresh_tables(o);
+        return std::nullopt;
+    });
     options["MultiPV"] << Option(1, 1, MAX_MOVES);
     options["Skill Level"] << Option(20, 0, 20);
     options["Move Overhead"] << Option(10, 0, 5000);
     options["nodestime"] << Option(0, 0, 10000);
-    options["UCI_Chess960"] << Option(false);
+    options["UCI_Chess960"] << Option(false, [this](const Option&) {
+        gameFen.clear();  // Moves may parse differently now, replay in full
+        return std::nullopt;
+    });
     options["UCI_LimitStrength"] << Option(false);
     options["UCI_Elo"] << Option(Stockfish::Search::Skill::LowestElo,
                                  Stockfish::Search::Skill::LowestElo,
                                  Stockfish::Search::Skill::HighestElo);
     options["UCI_ShowWDL"] << Option(false);
+    options["Book File"] << Option("<empty>", [this](const Option& o) -> std::optional<std::string> {
+        wait_for_search_finished();
+
+        std::string file = o;
+        if (file.empty() || file == "<empty>")
+        {
+            book.close();
+            return std::nullopt;
+        }
+
+        if (!book.open(file))
+            return "Unable to open book file: " + file;
+
+        return std::nullopt;
+    });
+    options["Param File"] << Option("<empty>", [this](const Option& o) -> std::optional<std::string> {
+        wait_for_search_finished();
+
+        std::string file = o;
+        if (file.empty() || file == "<empty>")
+            return std::nullopt;
+
+        if (!Tune::load_pack(file))
+            return "Unable to load parameter pack: " + file;
+
+        return std::nullopt;
+    });
+
     options["SyzygyPath"] << Option("", [](const Option& o) {
         Tablebases::init(o);
         return std::nullopt;
     });
+    options["SyzygyCacheSize"] << Option(16, 1, 1024, [](const Option& o) {
+        Tablebases::resize_cache(size_t(int(o)));
+        return std::nullopt;
+    });
     options["SyzygyProbeDepth"] << Option(1, 1, 100);
     options["Syzygy50MoveRule"] << Option(true);
     options["SyzygyProbeLimit"] << Option(7, 0, 7);
@@ -111,32 +206,113 @@ Engine::Engine(std::optional<std::string> path) :
         return std::nullopt;
     });
 
-    load_networks();
+    if (ownedNetworks)
+        load_networks();
     resize_threads();
 }
 
 std::uint64_t Engine::perft(const std::string& fen, Depth depth, bool isChess960) {
     verify_networks();
 
-    return Benchmark::perft(fen, depth, isChess960);
+    return Benchmark::perft(fen, depth, isChess960, threads);
+}
+
+std::pair<std::uint64_t, std::uint64_t> Engine::pawn_cache_stats() const {
+    return threads.pawn_cache_stats();
 }
 
 void Engine::go(Search::LimitsType& limits) {
     assert(limits.perft == 0);
+
+    // A pondering search that was stopped without a ponderhit still filled
+    // the table and its root statistics on the opponent's time. Mark the
+    // upcoming search so it keeps the TT generation the pondering search
+    // wrote (see Worker::start_searching()), and salvage the pondered root
+    // state below for GUIs that replay the predicted position as a plain
+    // 'go' instead of sending 'ponderhit'.
+    wait_for_search_finished();
+    const bool ponderMissed = lastGoWasPonder && threads.main_manager()->ponder;
+    limits.afterPonderMiss  = ponderMissed;
+    lastGoWasPonder         = limits.ponderMode;
+
+    // Probe the opening book before verifying networks or waking any search
+    // thread: a hit is answered instantly. When an instant answer is not
+    // allowed (pondering or infinite analysis), the book weights still seed
+    // the root move ordering below.
+    const auto bookMoves =
+      book.is_open() ? book.probe(pos) : std::vector<std::pair<Move, int>>{};
+
+    if (!bookMoves.empty() && !limits.infinite && !limits.ponderMode)
+    {
+        updateContext.onBestmove(UCIEngine::move(bookMoves.front().first, pos.is_chess960()), "");
+        pendingCheckpoint.reset();
+        return;
+    }
+
     verify_networks();
 
-    threads.start_thinking(options, pos, states, limits);
+    // Block on any replication still running in the background from a network
+    // load, so no search thread page-faults on network weights mid-search
+    networks.wait_replication();
+
+    // A loaded checkpoint applies only to the first search from the saved position
+    const Search::Checkpoint* checkpoint =
+      pendingCheckpoint && pendingCheckpoint->fen == pos.fen() ? &*pendingCheckpoint : nullptr;
+
+    // Resume the mispredicted pondering search when the new search targets
+    // the very position it pondered: same seeding path as a checkpoint, so
+    // the completed iterations and the root ordering are carried over.
+    Search::Checkpoint ponderSeed;
+    if (ponderMissed && !checkpoint)
+    {
+        ponderSeed = threads.make_checkpoint();
+        if (!ponderSeed.rootMoves.empty() && ponderSeed.fen == pos.fen())
+            checkpoint = &ponderSeed;
+    }
+
+    Search::Checkpoint bookSeed;
+    if (!bookMoves.empty() && !checkpoint)
+    {
+        bookSeed.fen = pos.fen();
+        for (const auto& [move, weight] : bookMoves)
+        {
+            (void) weight;  // The descending weight order is what matters
+            Search::Checkpoint::RootMoveState rm;
+            rm.pv.push_back(move);
+            bookSeed.rootMoves.push_back(std::move(rm));
+        }
+        checkpoint = &bookSeed;
+    }
+
+    // start_thinking() copies the seeded root moves into the workers before
+    // returning, so the checkpoint can be dropped as soon as it does.
+    threads.start_thinking(options, pos, states, limits, checkpoint);
+    pendingCheckpoint.reset();
+}
+void Engine::stop() {
+    latency_note_stop();
+    threads.stop = true;
 }
-void Engine::stop() { threads.stop = true; }
 
 void Engine::search_clear() {
     wait_for_search_finished();
 
-    tt.clear(threads);
+    // Re-read the parameter pack, if any, before the workers rebuild their
+    // derived tables below, so a file pushed between games takes effect at
+    // 'ucinewgame'. On failure the previously loaded values stay active.
+    if (std::string file = options["Param File"]; !file.empty() && file != "<empty>")
+        Tune::load_pack(file);
+
+    // Rebase instead of wiping: 'ucinewgame' costs microseconds even on huge
+    // tables, and the physical cleanup runs on an idle thread below
+    tt.rebase_clear(threads);
+    evalCache.clear();
     threads.clear();
 
     // @TODO wont work with multiple instances
     Tablebases::init(options["SyzygyPath"]);  // Free mapped files
+
+    threads.sweep_tt(tt);
 }
 
 void Engine::set_on_update_no_moves(std::function<void(const Engine::InfoShort&)>&& f) {
@@ -147,6 +323,10 @@ void Engine::set_on_update_full(std::function<void(const Engine::InfoFull&)>&& f
     updateContext.onUpdateFull = std::move(f);
 }
 
+void Engine::set_on_update_binary(std::function<void(const Search::InfoBinary&)>&& f) {
+    updateContext.onUpdateBinary = std::move(f);
+}
+
 void Engine::set_on_iter(std::function<void(const Engine::InfoIter&)>&& f) {
     updateContext.onIter = std::move(f);
 }
@@ -162,10 +342,43 @@ void Engine::set_on_verify_networks(std::function<void(std::string_view)>&& f) {
 void Engine::wait_for_search_finished() { threads.main_thread()->wait_for_search_finished(); }
 
 void Engine::set_position(const std::string& fen, const std::vector<std::string>& moves) {
+    // A new position invalidates any checkpoint armed for the old one
+    pendingCheckpoint.reset();
+
+    // Stateful fast path: when the new command replays the game we already
+    // hold and extends it, apply only the new suffix with do_move() instead
+    // of rebuilding and replaying the whole game. The StateInfo list is
+    // reclaimed from the thread pool, which took ownership at the last 'go'.
+    if (fen == gameFen && moves.size() >= gameMoves.size()
+        && std::equal(gameMoves.begin(), gameMoves.end(), moves.begin()))
+    {
+        if (!states)
+            states = threads.release_setup_states();
+
+        if (states)
+        {
+            for (std::size_t i = gameMoves.size(); i < moves.size(); ++i)
+            {
+                auto m = UCIEngine::to_move(pos, moves[i]);
+
+                if (m == Move::none())
+                    break;
+
+                states->emplace_back();
+                pos.do_move(m, states->back());
+                gameMoves.push_back(moves[i]);
+            }
+            return;
+        }
+    }
+
     // Drop the old state and create a new one
     states = StateListPtr(new std::deque<StateInfo>(1));
     pos.set(fen, options["UCI_Chess960"], &states->back());
 
+    gameFen = fen;
+    gameMoves.clear();
+
     for (const auto& move : moves)
     {
         auto m = UCIEngine::to_move(pos, move);
@@ -175,6 +388,7 @@ void Engine::set_position(const std::string& fen, const std::vector<std::string>
 
         states->emplace_back();
         pos.do_move(m, states->back());
+        gameMoves.push_back(move);
     }
 }
 
@@ -206,11 +420,17 @@ void Engine::set_numa_config_from_option(const std::string& o) {
 
 void Engine::resize_threads() {
     threads.wait_for_search_finished();
-    threads.set(numaContext.get_numa_config(), {options, threads, tt, networks}, updateContext);
+    threads.set(numaContext.get_numa_config(), {options, threads, tt, evalCache, networks}, updateContext);
 
-    // Reallocate the hash with the new threadpool size
-    set_tt_size(options["Hash"]);
+    // Reallocate the hash with the new threadpool size, refreshing the NUMA
+    // layout as well since the node count may have changed with the binding.
+    set_tt_layout(options["NUMA TT Layout"]);
     threads.ensure_network_replicated();
+    threads.setup_shared_refresh_tables(options["Shared Finny Tables"]);
+    threads.set_tt_cache_size(size_t(int(options["L1 Hash"])));
+    threads.set_qsearch_cache(bool(int(options["QSearch Cache"])));
+    threads.set_node_trace_size(size_t(int(options["Trace Nodes"])));
+    evalCache.resize(size_t(int(options["Eval Cache"])));
 }
 
 void Engine::set_tt_size(size_t mb) {
@@ -218,6 +438,136 @@ void Engine::set_tt_size(size_t mb) {
     tt.resize(mb, threads);
 }
 
+void Engine::set_tt_layout(const std::string& layout) {
+    wait_for_search_finished();
+
+    const TTLayout newLayout = layout == "Interleaved" ? TTLayout::Interleaved
+                             : layout == "Partitioned" ? TTLayout::Partitioned
+                                                       : TTLayout::Flat;
+
+    tt.set_layout(newLayout, numaContext.get_numa_config().num_numa_nodes());
+
+    // Reallocate so that the pages are first-touched according to the new layout
+    set_tt_size(options["Hash"]);
+}
+
+bool Engine::save_tt(const std::string& file, bool incremental) {
+    wait_for_search_finished();
+    return tt.save(file, incremental);
+}
+
+bool Engine::load_tt(const std::string& file) {
+    wait_for_search_finished();
+    return tt.load(file);
+}
+
+bool Engine::dump_node_trace(const std::string& file) {
+    wait_for_search_finished();
+    return threads.dump_node_trace(file);
+}
+
+bool Engine::save_checkpoint(const std::string& file, bool includeTT) {
+    wait_for_search_finished();
+
+    Search::Checkpoint ckpt = threads.make_checkpoint();
+    if (!ckpt.depth || ckpt.rootMoves.empty())
+        return false;
+
+    std::ofstream out(file, std::ios::trunc);
+    if (!out)
+        return false;
+
+    out << "checkpoint 1\n"
+        << ckpt.fen << "\n"
+        << ckpt.depth << " " << ckpt.rootMoves.size() << "\n";
+
+    // Moves are stored in their raw 16-bit encoding: restoring UCI strings
+    // would need the position after every PV prefix, the raw form does not.
+    for (const auto& rm : ckpt.rootMoves)
+    {
+        out << rm.score << " " << rm.previousScore << " " << rm.averageScore << " "
+            << rm.meanSquaredScore << " " << rm.pv.size();
+        for (Move m : rm.pv)
+            out << " " << m.raw();
+        out << "\n";
+    }
+
+    if (!out)
+        return false;
+
+    return !includeTT || save_tt(file + ".tt", false);
+}
+
+bool Engine::load_checkpoint(const std::string& file) {
+    wait_for_search_finished();
+
+    std::ifstream in(file);
+    std::string   magic;
+    int           version;
+    if (!(in >> magic >> version) || magic != "checkpoint" || version != 1)
+        return false;
+
+    Search::Checkpoint ckpt;
+    size_t             count;
+    in >> std::ws;
+    if (!std::getline(in, ckpt.fen) || !(in >> ckpt.depth >> count) || ckpt.depth <= 0
+        || ckpt.depth >= MAX_PLY || count > MAX_MOVES)
+        return false;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        Search::Checkpoint::RootMoveState rm;
+        size_t                            pvLen;
+        if (!(in >> rm.score >> rm.previousScore >> rm.averageScore >> rm.meanSquaredScore
+              >> pvLen)
+            || pvLen > MAX_PLY)
+            return false;
+
+        for (size_t j = 0; j < pvLen; ++j)
+        {
+            int raw;
+            if (!(in >> raw))
+                return false;
+            rm.pv.push_back(Move(std::uint16_t(raw)));
+        }
+        ckpt.rootMoves.push_back(std::move(rm));
+    }
+
+    // Truncate each PV at the first move that is not legal from the saved
+    // position, dropping moves mangled on disk; seeding in start_thinking()
+    // additionally matches pv[0] against the current legal moves.
+    for (auto& rm : ckpt.rootMoves)
+    {
+        std::deque<StateInfo> st(1);
+        Position              p;
+        p.set(ckpt.fen, options["UCI_Chess960"], &st.front());
+
+        size_t n = 0;
+        for (Move m : rm.pv)
+        {
+            if (!p.pseudo_legal(m) || !p.legal(m))
+                break;
+            st.emplace_back();
+            p.do_move(m, st.back());
+            ++n;
+        }
+        rm.pv.resize(n);
+    }
+
+    set_position(ckpt.fen, {});
+    pendingCheckpoint = std::move(ckpt);  // After set_position(), which resets it
+
+    // A hash snapshot alongside the checkpoint is optional
+    std::ifstream ttFile(file + ".tt");
+    if (ttFile)
+    {
+        ttFile.close();
+        load_tt(file + ".tt");
+    }
+
+    return true;
+}
+
 void Engine::set_ponderhit(bool b) { threads.main_manager()->ponder = b; }
 
 // network related
@@ -227,27 +577,42 @@ void Engine::verify_networks() const {
     networks->small.verify(options["EvalFileSmall"], onVerifyNetworks);
 }
 
+// After a (re)load the per-node copies are kicked off in the background
+// rather than made synchronously: replication is tens of MB of cross-node
+// memcpy and would otherwise serialize engine-ready latency behind it. go()
+// blocks on the pending replication before any search thread runs.
 void Engine::load_networks() {
+    // Shared networks belong to the donor instance; reloading them here would
+    // race with sibling sessions that may be searching
+    if (!ownedNetworks)
+        return;
+
     networks.modify_and_replicate([this](NN::Networks& networks_) {
         networks_.big.load(binaryDirectory, options["EvalFile"]);
         networks_.small.load(binaryDirectory, options["EvalFileSmall"]);
     });
     threads.clear();
-    threads.ensure_network_replicated();
+    networks.replicate_async();
 }
 
 void Engine::load_big_network(const std::string& file) {
+    if (!ownedNetworks)
+        return;
+
     networks.modify_and_replicate(
       [this, &file](NN::Networks& networks_) { networks_.big.load(binaryDirectory, file); });
     threads.clear();
-    threads.ensure_network_replicated();
+    networks.replicate_async();
 }
 
 void Engine::load_small_network(const std::string& file) {
+    if (!ownedNetworks)
+        return;
+
     networks.modify_and_replicate(
       [this, &file](NN::Networks& networks_) { networks_.small.load(binaryDirectory, file); });
     threads.clear();
-    threads.ensure_network_replicated();
+    networks.replicate_async();
 }
 
 void Engine::save_network(const std::pair<std::optional<std::string>, std::string> files[2]) {
@@ -257,6 +622,37 @@ void Engine::save_network(const std::pair<std::optional<std::string>, std::strin
     });
 }
 
+void Engine::save_network_raw(const std::pair<std::optional<std::string>, std::string> files[2]) {
+    networks.modify_and_replicate([&files](NN::Networks& networks_) {
+        networks_.big.save_raw(files[0].first);
+        networks_.small.save_raw(files[1].first);
+    });
+}
+
+std::vector<int> Engine::evaluate_batch(const std::vector<std::string>& fens) {
+    verify_networks();
+
+    // One cache set serves the whole batch, so consecutive positions sharing
+    // king placement hit warm accumulator entries instead of refreshing from scratch.
+    auto caches = std::make_unique<Eval::NNUE::AccumulatorCaches>(*networks);
+
+    std::vector<int> scores;
+    scores.reserve(fens.size());
+
+    for (const auto& fen : fens)
+    {
+        StateInfo st;
+        Position  p;
+        p.set(fen, options["UCI_Chess960"], &st);
+
+        scores.push_back(p.checkers()
+                           ? VALUE_NONE
+                           : UCIEngine::to_cp(Eval::evaluate(*networks, p, *caches, 0), p));
+    }
+
+    return scores;
+}
+
 // utility functions
 
 void Engine::trace_eval() const {
@@ -274,7 +670,10 @@ OptionsMap&       Engine::get_options() { return options; }
 
 std::string Engine::fen() const { return pos.fen(); }
 
-void Engine::flip() { pos.flip(); }
+void Engine::flip() {
+    pos.flip();
+    gameFen.clear();  // 'pos' no longer matches the tracked game
+}
 
 std::string Engine::visualize() const {
     std::stringstream ss;
@@ -28,6 +28,7 @@
 #include <utility>
 #include <vector>
 
+#include "book.h"
 #include "nnue/network.h"
 #include "numa.h"
 #include "position.h"
@@ -39,13 +40,23 @@
 
 namespace Stockfish {
 
+// The in-process engine API, used both by the UCI front end and by embedders
+// linking libstockfish ('make lib'). After the one-time global Bitboards::init()
+// and Position::init(), multiple Engine instances can coexist, each with its
+// own thread pool, transposition table and options; only the Syzygy tablebase
+// configuration is still process-global.
 class Engine {
    public:
     using InfoShort = Search::InfoShort;
     using InfoFull  = Search::InfoFull;
     using InfoIter  = Search::InfoIteration;
 
-    Engine(std::optional<std::string> path = std::nullopt);
+    // Passing sharedNetworks makes the instance borrow another engine's
+    // already replicated networks read-only instead of loading its own, so
+    // N instances in one process pay for one copy (see 'multiuci'). The
+    // donor must outlive this instance; only the donor reloads networks.
+    Engine(std::optional<std::string>               path = std::nullopt,
+           LazyNumaReplicated<Eval::NNUE::Networks>* sharedNetworks = nullptr);
 
     // Cannot be movable due to components holding backreferences to fields
     Engine(const Engine&)            = delete;
@@ -57,6 +68,14 @@ class Engine {
 
     std::uint64_t perft(const std::string& fen, Depth depth, bool isChess960);
 
+    // Summed pawn-structure cache {probes, hits} over all search threads
+    std::pair<std::uint64_t, std::uint64_t> pawn_cache_stats() const;
+
+    // Statically evaluates a batch of FEN strings, reusing one set of accumulator
+    // caches across the whole batch. Returns centipawn scores from the side to
+    // move's point of view; positions in check yield VALUE_NONE.
+    std::vector<int> evaluate_batch(const std::vector<std::string>& fens);
+
     // non blocking call to start searching
     void go(Search::LimitsType&);
     // non blocking call to stop searching
@@ -72,11 +91,31 @@ class Engine {
     void set_numa_config_from_option(const std::string& o);
     void resize_threads();
     void set_tt_size(size_t mb);
+    void set_tt_layout(const std::string& layout);
+    bool save_tt(const std::string& file, bool incremental);
+    bool load_tt(const std::string& file);
+
+    // Session checkpointing for preemptible analysis jobs, see Search::Checkpoint.
+    // save_checkpoint() snapshots the root position and the root move state of
+    // the last finished search, optionally together with the hash table (stored
+    // in a '<file>.tt' sibling in the 'tt save' format). load_checkpoint()
+    // restores the position and arms the snapshot so that the next go() resumes
+    // iterative deepening at the saved depth; it is dropped if the position
+    // changes first.
+    bool save_checkpoint(const std::string& file, bool includeTT);
+    bool load_checkpoint(const std::string& file);
+
+    // Writes the node trace rings collected with 'Trace Nodes' to disk,
+    // see nodetrace.h
+    bool dump_node_trace(const std::string& file);
     void set_ponderhit(bool);
     void search_clear();
 
     void set_on_update_no_moves(std::function<void(const InfoShort&)>&&);
     void set_on_update_full(std::function<void(const InfoFull&)>&&);
+    // Installing a binary update callback replaces the string-formatted
+    // InfoFull updates entirely, see Search::InfoBinary
+    void set_on_update_binary(std::function<void(const Search::InfoBinary&)>&&);
     void set_on_iter(std::function<void(const InfoIter&)>&&);
     void set_on_bestmove(std::function<void(std::string_view, std::string_view)>&&);
     void set_on_verify_networks(std::function<void(std::string_view)>&&);
@@ -85,9 +124,13 @@ class Engine {
 
     void verify_networks() const;
     void load_networks();
+
+    // The replicated networks, for donation to sibling instances
+    LazyNumaReplicated<Eval::NNUE::Networks>& shared_networks() { return networks; }
     void load_big_network(const std::string& file);
     void load_small_network(const std::string& file);
     void save_network(const std::pair<std::optional<std::string>, std::string> files[2]);
+    void save_network_raw(const std::pair<std::optional<std::string>, std::string> files[2]);
 
     // utility functions
 
@@ -115,13 +158,31 @@ class Engine {
     Position     pos;
     StateListPtr states;
 
+    // The game 'pos'/'states' were built from, so a 'position' command that
+    // merely extends it is applied incrementally, see set_position()
+    std::string              gameFen;
+    std::vector<std::string> gameMoves;
+
     OptionsMap                               options;
     ThreadPool                               threads;
-    TranspositionTable                       tt;
-    LazyNumaReplicated<Eval::NNUE::Networks> networks;
+    TranspositionTable tt;
+    EvalCache          evalCache;
+
+    // Own networks storage, empty when sharing a donor's; all use goes
+    // through the reference so both arrangements look the same
+    std::unique_ptr<LazyNumaReplicated<Eval::NNUE::Networks>> ownedNetworks;
+    LazyNumaReplicated<Eval::NNUE::Networks>&                 networks;
+    PolyglotBook                             book;
 
     Search::SearchManager::UpdateContext  updateContext;
     std::function<void(std::string_view)> onVerifyNetworks;
+
+    // Loaded but not yet resumed checkpoint, consumed by the next go()
+    std::optional<Search::Checkpoint> pendingCheckpoint;
+
+    // Whether the previous go() was a pondering search, to recognize a
+    // ponder-miss at the start of the next one
+    bool lastGoWasPonder = false;
 };
 
 }  // namespace Stockfish
@@ -50,27 +50,42 @@ bool Eval::use_smallnet(const Position& pos) {
     return std::abs(simpleEval) > 962;
 }
 
+namespace {
+
+// Scaling constants shared by evaluate() and evaluate_psqt(), which blends
+// the PSQT term the same way with the positional term taken as zero; a
+// single definition keeps the two paths from drifting apart when retuned
+constexpr int PsqtWeight       = 125;  // NNUE blend numerators, over WeightScale
+constexpr int PositionalWeight = 131;
+constexpr int WeightScale      = 128;
+constexpr int PawnMaterial     = 535;    // Pawn weight in the material blend term
+constexpr int MaterialScale    = 77777;  // Denominator of the material blend
+constexpr int Rule50Damp       = 212;    // Shuffling damping divisor
+
+}
+
 // Evaluate is the evaluator for the outer world. It returns a static evaluation
 // of the position from the point of view of the side to move.
 Value Eval::evaluate(const Eval::NNUE::Networks&    networks,
                      const Position&                pos,
                      Eval::NNUE::AccumulatorCaches& caches,
-                     int                            optimism) {
+                     int                            optimism,
+                     bool                           smallNetOnly) {
 
     assert(!pos.checkers());
 
-    bool smallNet           = use_smallnet(pos);
+    bool smallNet           = smallNetOnly || use_smallnet(pos);
     auto [psqt, positional] = smallNet ? networks.small.evaluate(pos, &caches.small)
                                        : networks.big.evaluate(pos, &caches.big);
 
-    Value nnue = (125 * psqt + 131 * positional) / 128;
+    Value nnue = (PsqtWeight * psqt + PositionalWeight * positional) / WeightScale;
 
     // Re-evaluate the position when higher eval accuracy is worth the time spent
-    if (smallNet && (std::abs(nnue) < 236))
+    if (smallNet && !smallNetOnly && (std::abs(nnue) < 236))
     {
         std::tie(psqt, positional) = networks.big.evaluate(pos, &caches.big);
-        nnue                       = (125 * psqt + 131 * positional) / 128;
-        smallNet                   = false;
+        nnue = (PsqtWeight * psqt + PositionalWeight * positional) / WeightScale;
+        smallNet = false;
     }
 
     // Blend optimism and eval with nnue complexity
@@ -78,11 +93,11 @@ Value Eval::evaluate(const Eval::NNUE::Networks&    networks,
     optimism += optimism * nnueComplexity / 468;
     nnue -= nnue * nnueComplexity / (smallNet ? 20233 : 17879);
 
-    int material = 535 * pos.count<PAWN>() + pos.non_pawn_material();
-    int v        = (nnue * (77777 + material) + optimism * (7777 + material)) / 77777;
+    int material = PawnMaterial * pos.count<PAWN>() + pos.non_pawn_material();
+    int v = (nnue * (MaterialScale + material) + optimism * (7777 + material)) / MaterialScale;
 
     // Damp down the evaluation linearly when shuffling
-    v -= v * pos.rule50_count() / 212;
+    v -= v * pos.rule50_count() / Rule50Damp;
 
     // Guarantee evaluation does not hit the tablebase range
     v = std::clamp(v, VALUE_TB_LOSS_IN_MAX_PLY + 1, VALUE_TB_WIN_IN_MAX_PLY - 1);
@@ -90,6 +105,33 @@ Value Eval::evaluate(const Eval::NNUE::Networks&    networks,
     return v;
 }
 
+// The PSQT half of the network output comes straight from the accumulator,
+// which has to be kept up to date anyway; reading it skips the perspective
+// transform and the whole layer stack. The result is scaled like in
+// evaluate() with the positional term taken as zero, so it is an estimate
+// whose error is bounded by the positional range plus the blend terms.
+Value Eval::evaluate_psqt(const Eval::NNUE::Networks&    networks,
+                          const Position&                pos,
+                          Eval::NNUE::AccumulatorCaches& caches,
+                          bool                           smallNetOnly) {
+
+    assert(!pos.checkers());
+
+    bool  smallNet = smallNetOnly || use_smallnet(pos);
+    Value psqt     = smallNet ? networks.small.evaluate_psqt(pos, &caches.small)
+                              : networks.big.evaluate_psqt(pos, &caches.big);
+
+    int nnue = PsqtWeight * psqt / WeightScale;
+
+    int material = PawnMaterial * pos.count<PAWN>() + pos.non_pawn_material();
+    int v        = nnue * (MaterialScale + material) / MaterialScale;
+
+    // Damp down the evaluation linearly when shuffling
+    v -= v * pos.rule50_count() / Rule50Damp;
+
+    return std::clamp(v, VALUE_TB_LOSS_IN_MAX_PLY + 1, VALUE_TB_WIN_IN_MAX_PLY - 1);
+}
+
 // Like evaluate(), but instead of returning a value, it returns
 // a string (suitable for outputting to stdout) that contains the detailed
 // descriptions and values of each evaluation term. Useful for debugging.
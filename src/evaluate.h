@@ -45,10 +45,20 @@ std::string trace(Position& pos, const Eval::NNUE::Networks& networks);
 
 int   simple_eval(const Position& pos, Color c);
 bool  use_smallnet(const Position& pos);
+// With 'smallNetOnly' evaluation is pinned to the small network, skipping the
+// big-net accumulator maintenance entirely ('go smallnet')
 Value evaluate(const NNUE::Networks&          networks,
                const Position&                pos,
                Eval::NNUE::AccumulatorCaches& caches,
-               int                            optimism);
+               int                            optimism,
+               bool                           smallNetOnly = false);
+
+// Cheap estimate from the PSQT half of the network output alone, scaled like
+// evaluate() with the positional term unknown; see Search::Worker::evaluate()
+Value evaluate_psqt(const NNUE::Networks&          networks,
+                    const Position&                pos,
+                    Eval::NNUE::AccumulatorCaches& caches,
+                    bool                           smallNetOnly = false);
 }  // namespace Eval
 
 }  // namespace Stockfish
@@ -63,59 +63,157 @@ inline int non_pawn_index(const Position& pos) {
     return pos.non_pawn_key(c) & (CORRECTION_HISTORY_SIZE - 1);
 }
 
-// StatsEntry is the container of various numerical statistics. We use a class
-// instead of a naked value to directly call history update operator<<() on
-// the entry. The first template parameter T is the base type of the array,
-// and the second template parameter D limits the range of updates in [-D, D]
-// when we update values with the << operator
-template<typename T, int D>
-class StatsEntry {
+// Epoch used for lazy aging of the history tables. Bumping the thread's epoch
+// invalidates every Stats table owned by this thread at once, making the
+// between-games history reset O(1): a table whose tag does not match the
+// current epoch reads as its fill value everywhere and re-fills on its first
+// update, similar in spirit to TTEntry::relative_age(). Tables are only ever
+// touched by their owning search thread, so a plain thread_local suffices.
+inline thread_local std::uint8_t HistoryEpoch = 0;
+
+// Reference to one statistics entry, returned by Stats element access so the
+// usual read / operator=() / history-update operator<<() syntax keeps working
+// on the packed storage. Reads substitute the table's fill value while the
+// owning table is stale; writes first materialize() the table.
+template<typename StatsT>
+class StatsRef {
+    using T        = typename StatsT::value_type;
+    using EntryRef = std::conditional_t<std::is_const_v<StatsT>, const T&, T&>;
+
+    StatsT&  stats;
+    EntryRef entry;
 
-    static_assert(std::is_arithmetic<T>::value, "Not an arithmetic type");
-    static_assert(D <= std::numeric_limits<T>::max(), "D overflows T");
+   public:
+    StatsRef(StatsT& s, EntryRef e) :
+        stats(s),
+        entry(e) {}
 
-    T entry;
+    operator T() const { return stats.fresh() ? entry : T(StatsT::FillValue); }
 
-   public:
-    StatsEntry& operator=(const T& v) {
+    StatsRef& operator=(const T& v) {
+        stats.materialize();
         entry = v;
         return *this;
     }
-    operator const T&() const { return entry; }
 
     void operator<<(int bonus) {
+        constexpr int D = StatsT::UpdateLimit;
+
         // Make sure that bonus is in range [-D, D]
         int clampedBonus = std::clamp(bonus, -D, D);
-        entry += clampedBonus - entry * std::abs(clampedBonus) / D;
+
+        stats.materialize();
+        entry = entry + clampedBonus - entry * std::abs(clampedBonus) / D;
 
         assert(std::abs(entry) <= D);
     }
 };
 
+// Intermediate dimension of a Stats table, forwarding indexing down to the
+// entries while carrying the owning table along for its epoch tag.
+template<typename StatsT, typename SubT>
+class StatsView {
+    StatsT& stats;
+    SubT&   sub;
+
+   public:
+    StatsView(StatsT& s, SubT& a) :
+        stats(s),
+        sub(a) {}
+
+    decltype(auto) operator[](std::size_t i) const {
+        using E = std::remove_reference_t<decltype(sub[i])>;
+        if constexpr (std::is_same_v<std::remove_const_t<E>, typename StatsT::value_type>)
+            return StatsRef<StatsT>(stats, sub[i]);
+        else
+            return StatsView<StatsT, E>(stats, sub[i]);
+    }
+};
+
 enum StatsType {
     NoCaptures,
     Captures
 };
 
-template<typename T, int D, std::size_t... Sizes>
-using Stats = MultiArray<StatsEntry<T, D>, Sizes...>;
+// Stats is the container of various numerical statistics. Entries are packed
+// raw values of the base type T, so twice as many fit in a cache line as with
+// a per-entry epoch tag, and one tag per table replaces per-entry staleness
+// checks: a whole table is fresh or stale as a unit. Reads from a stale table
+// yield FV and the first write of a new epoch re-fills the table eagerly, so
+// the O(1) between-games reset is kept while the hot scoring loads see plain
+// int16 arrays (see the batched pass in MovePicker::score()). The template
+// parameter D limits the range of updates in [-D, D] when values are updated
+// with the << operator, and FV is the table's fill value.
+template<typename T, int D, int FV, std::size_t... Sizes>
+class Stats {
+    static_assert(std::is_arithmetic<T>::value, "Not an arithmetic type");
+    static_assert(D <= std::numeric_limits<T>::max(), "D overflows T");
+
+   public:
+    using value_type = T;
+
+    static constexpr int         UpdateLimit = D;
+    static constexpr int         FillValue   = FV;
+    static constexpr std::size_t NumEntries  = (Sizes * ...);
+
+    void fill(const T& v) {
+        std::fill_n(reinterpret_cast<T*>(&data), NumEntries, v);
+        epoch = HistoryEpoch;
+    }
+
+    bool fresh() const { return epoch == HistoryEpoch; }
+
+    void materialize() {
+        if (!fresh())
+            fill(T(FV));
+    }
+
+    // Contiguous base of all entries, for the vectorized scoring path. The
+    // values are only meaningful when fresh() holds; a stale table reads as
+    // FV everywhere.
+    const T* flat() const { return reinterpret_cast<const T*>(&data); }
+
+    decltype(auto) operator[](std::size_t i) {
+        using E = std::remove_reference_t<decltype(data[i])>;
+        if constexpr (std::is_same_v<E, T>)
+            return StatsRef<Stats>(*this, data[i]);
+        else
+            return StatsView<Stats, E>(*this, data[i]);
+    }
+
+    decltype(auto) operator[](std::size_t i) const {
+        using E = std::remove_reference_t<decltype(data[i])>;
+        if constexpr (std::is_same_v<std::remove_const_t<E>, T>)
+            return StatsRef<const Stats>(*this, data[i]);
+        else
+            return StatsView<const Stats, E>(*this, data[i]);
+    }
+
+   private:
+    MultiArray<T, Sizes...> data;
+
+    // Stale on construction, so the entries read as FV until the first fill()
+    // or write. A worker's first clear() still does an eager fill, see
+    // Search::Worker::clear().
+    std::uint8_t epoch = std::uint8_t(HistoryEpoch - 1);
+};
 
 // ButterflyHistory records how often quiet moves have been successful or unsuccessful
 // during the current search, and is used for reduction and move ordering decisions.
 // It uses 2 tables (one for each color) indexed by the move's from and to squares,
 // see https://www.chessprogramming.org/Butterfly_Boards (~11 elo)
-using ButterflyHistory = Stats<std::int16_t, 7183, COLOR_NB, int(SQUARE_NB) * int(SQUARE_NB)>;
+using ButterflyHistory = Stats<std::int16_t, 7183, 63, COLOR_NB, int(SQUARE_NB) * int(SQUARE_NB)>;
 
 // LowPlyHistory is adressed by play and move's from and to squares, used
 // to improve move ordering near the root
 using LowPlyHistory =
-  Stats<std::int16_t, 7183, LOW_PLY_HISTORY_SIZE, int(SQUARE_NB) * int(SQUARE_NB)>;
+  Stats<std::int16_t, 7183, 108, LOW_PLY_HISTORY_SIZE, int(SQUARE_NB) * int(SQUARE_NB)>;
 
 // CapturePieceToHistory is addressed by a move's [piece][to][captured piece type]
-using CapturePieceToHistory = Stats<std::int16_t, 10692, PIECE_NB, SQUARE_NB, PIECE_TYPE_NB>;
+using CapturePieceToHistory = Stats<std::int16_t, 10692, -631, PIECE_NB, SQUARE_NB, PIECE_TYPE_NB>;
 
 // PieceToHistory is like ButterflyHistory but is addressed by a move's [piece][to]
-using PieceToHistory = Stats<std::int16_t, 30000, PIECE_NB, SQUARE_NB>;
+using PieceToHistory = Stats<std::int16_t, 30000, -479, PIECE_NB, SQUARE_NB>;
 
 // ContinuationHistory is the combined history of a given pair of moves, usually
 // the current one given a previous one. The nested history table is based on
@@ -124,7 +222,7 @@ using PieceToHistory = Stats<std::int16_t, 30000, PIECE_NB, SQUARE_NB>;
 using ContinuationHistory = MultiArray<PieceToHistory, PIECE_NB, SQUARE_NB>;
 
 // PawnHistory is addressed by the pawn structure and a move's [piece][to]
-using PawnHistory = Stats<std::int16_t, 8192, PAWN_HISTORY_SIZE, PIECE_NB, SQUARE_NB>;
+using PawnHistory = Stats<std::int16_t, 8192, -1210, PAWN_HISTORY_SIZE, PIECE_NB, SQUARE_NB>;
 
 // Correction histories record differences between the static evaluation of
 // positions and their search score. It is used to improve the static evaluation
@@ -142,12 +240,12 @@ namespace Detail {
 
 template<CorrHistType>
 struct CorrHistTypedef {
-    using type = Stats<std::int16_t, CORRECTION_HISTORY_LIMIT, CORRECTION_HISTORY_SIZE, COLOR_NB>;
+    using type = Stats<std::int16_t, CORRECTION_HISTORY_LIMIT, 0, CORRECTION_HISTORY_SIZE, COLOR_NB>;
 };
 
 template<>
 struct CorrHistTypedef<PieceTo> {
-    using type = Stats<std::int16_t, CORRECTION_HISTORY_LIMIT, PIECE_NB, SQUARE_NB>;
+    using type = Stats<std::int16_t, CORRECTION_HISTORY_LIMIT, 0, PIECE_NB, SQUARE_NB>;
 };
 
 template<>
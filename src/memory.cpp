@@ -18,7 +18,9 @@
 
 #include "memory.h"
 
+#include <cstdio>
 #include <cstdlib>
+#include <new>
 
 #if __has_include("features.h")
     #include <features.h>
@@ -28,6 +30,13 @@
     #include <sys/mman.h>
 #endif
 
+#if !defined(_WIN32)
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
 #if defined(__APPLE__) || defined(__ANDROID__) || defined(__OpenBSD__) \
   || (defined(__GLIBCXX__) && !defined(_GLIBCXX_HAVE_ALIGNED_ALLOC) && !defined(_WIN32)) \
   || defined(__e2k__)
@@ -212,6 +221,63 @@ void* aligned_large_pages_alloc(size_t allocSize) {
 
 #endif
 
+
+// Maps a named shared-memory segment of the given size, creating it if it
+// does not exist yet, so cooperating engine processes on one host can share
+// one allocation. `created` tells the caller whether it is the first process
+// to attach (and therefore responsible for initializing the contents).
+// Returns nullptr on failure, or on platforms without POSIX shared memory.
+
+#if defined(_WIN32)
+
+void* shared_memory_map(const std::string&, size_t, bool&) { return nullptr; }
+
+void shared_memory_unmap(void*, size_t) {}
+
+#else
+
+void* shared_memory_map(const std::string& name, size_t size, bool& created) {
+
+    const std::string shmName = name[0] == '/' ? name : "/" + name;
+
+    created = true;
+    int fd  = shm_open(shmName.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0 && errno == EEXIST)
+    {
+        created = false;
+        fd      = shm_open(shmName.c_str(), O_RDWR, 0600);
+    }
+    if (fd < 0)
+        return nullptr;
+
+    if (created && ftruncate(fd, off_t(size)) != 0)
+    {
+        close(fd);
+        shm_unlink(shmName.c_str());
+        return nullptr;
+    }
+
+    void* mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (mem == MAP_FAILED)
+        return nullptr;
+
+    #if defined(MADV_HUGEPAGE)
+    madvise(mem, size, MADV_HUGEPAGE);
+    #endif
+
+    return mem;
+}
+
+void shared_memory_unmap(void* mem, size_t size) {
+    if (mem)
+        munmap(mem, size);
+}
+
+#endif
+
+
 bool has_large_pages() {
 
 #if defined(_WIN32)
@@ -264,5 +330,56 @@ void aligned_large_pages_free(void* mem) {
 
 void aligned_large_pages_free(void* mem) { std_aligned_free(mem); }
 
+#endif
+
+
+// Zero-allocation search guard, see the comment in memory.h. The depth
+// counter is thread-local so that the guard held by a search thread never
+// affects the input reader or an embedding application's threads. A suspend
+// decrements the counter, so holding one inside a guarded region disarms the
+// guard and holding one outside (counter -1) is harmless.
+#ifndef NDEBUG
+
+namespace {
+thread_local int allocGuardDepth = 0;
+}
+
+AllocGuard::AllocGuard() { ++allocGuardDepth; }
+AllocGuard::~AllocGuard() { --allocGuardDepth; }
+AllocSuspend::AllocSuspend() { --allocGuardDepth; }
+AllocSuspend::~AllocSuspend() { ++allocGuardDepth; }
+
+namespace {
+bool alloc_guard_active() { return allocGuardDepth > 0; }
+}
+
 #endif
 }  // namespace Stockfish
+
+// The replacement global allocation functions backing the guard. They stay
+// out of release builds entirely: there the normal library allocator is used
+// and the guard types are empty.
+#ifndef NDEBUG
+
+void* operator new(std::size_t count) {
+
+    if (Stockfish::alloc_guard_active())
+    {
+        std::fputs("Heap allocation during guarded search, aborting\n", stderr);
+        std::abort();
+    }
+
+    if (void* p = std::malloc(count ? count : 1))
+        return p;
+
+    std::abort();
+}
+
+void* operator new[](std::size_t count) { return operator new(count); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+#endif
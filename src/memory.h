@@ -24,6 +24,7 @@
 #include <cstdint>
 #include <memory>
 #include <new>
+#include <string>
 #include <type_traits>
 #include <utility>
 
@@ -38,8 +39,40 @@ void  std_aligned_free(void* ptr);
 void* aligned_large_pages_alloc(size_t size);
 void  aligned_large_pages_free(void* mem);
 
+// Named shared-memory segment, for allocations shared between cooperating
+// engine processes on one host. Unsupported platforms return nullptr.
+void* shared_memory_map(const std::string& name, size_t size, bool& created);
+void  shared_memory_unmap(void* mem, size_t size);
+
 bool has_large_pages();
 
+// Zero-allocation search guard. In debug builds the global operator new is
+// replaced (see memory.cpp) and aborts with a message while a thread holds an
+// AllocGuard, so any heap traffic sneaking into the search shows up as a hard
+// failure instead of an ms-scale malloc outlier in a latency trace. The
+// search brackets its iterative-deepening loop with a guard; paths that are
+// allowed to allocate, like the info-line emission, hold an AllocSuspend.
+// Both are thread-local and nestable; release builds compile them away.
+#ifndef NDEBUG
+struct AllocGuard {
+    AllocGuard();
+    ~AllocGuard();
+};
+
+struct AllocSuspend {
+    AllocSuspend();
+    ~AllocSuspend();
+};
+#else
+struct AllocGuard {
+    AllocGuard() {}
+};
+
+struct AllocSuspend {
+    AllocSuspend() {}
+};
+#endif
+
 // Frees memory which was placed there with placement new.
 // Works for both single objects and arrays of unknown bound.
 template<typename T, typename FREE_FUNC>
@@ -394,6 +394,120 @@ void dbg_print() {
 }
 
 
+#ifdef ENABLE_STATS
+
+namespace {
+
+std::array<std::atomic<int64_t>, STATS_NB> statsCounters{};
+
+constexpr const char* StatsNames[STATS_NB] = {"tt_probe",  "tt_hit",     "tt_overwrite",
+                                              "acc_refresh", "acc_update", "mp_stage",
+                                              "tb_probe"};
+}  // namespace
+
+void stats_count(StatsCounter type) { statsCounters[type].fetch_add(1, std::memory_order_relaxed); }
+
+// Dumps all counters on one machine-parsable line and resets them, so the
+// output of successive searches can be diffed directly.
+void stats_print() {
+
+    std::ostringstream ss;
+    ss << "info string stats";
+    for (size_t i = 0; i < STATS_NB; ++i)
+        ss << ' ' << StatsNames[i] << '=' << statsCounters[i].exchange(0);
+
+    sync_cout << ss.str() << sync_endl;
+}
+
+#endif
+
+
+// Latency histograms, see the comment in misc.h. Everything is lock-free so
+// that the recording sites in the search and the 'latencystats' dump can run
+// concurrently.
+namespace {
+
+// Bucket b counts samples of 2^(b-1) <= ms < 2^b, bucket 0 the sub-millisecond
+// ones and the last bucket is open-ended.
+constexpr int LatencyBuckets = 16;
+
+std::atomic<bool>      latencyEnabled{false};
+std::atomic<TimePoint> latencyStopTime{0};
+
+std::array<std::array<std::atomic<int64_t>, LatencyBuckets>, LATENCY_NB> latencyHist{};
+std::array<std::atomic<int64_t>, LATENCY_NB>                             latencyMax{};
+
+constexpr const char* LatencyNames[LATENCY_NB] = {"first_info", "iteration", "stop_to_bestmove"};
+
+}  // namespace
+
+void latency_enable(bool b) { latencyEnabled.store(b, std::memory_order_relaxed); }
+
+void latency_record(LatencyMetric metric, TimePoint duration) {
+
+    if (!latencyEnabled.load(std::memory_order_relaxed))
+        return;
+
+    int bucket = 0;
+    for (TimePoint d = duration; d > 0 && bucket < LatencyBuckets - 1; d >>= 1)
+        ++bucket;
+
+    latencyHist[metric][bucket].fetch_add(1, std::memory_order_relaxed);
+
+    int64_t m = latencyMax[metric].load(std::memory_order_relaxed);
+    while (m < duration && !latencyMax[metric].compare_exchange_weak(m, duration))
+    {}
+}
+
+// Only the first stop signal of a search wins the timestamp slot; it is freed
+// again when the matching bestmove closes the interval.
+void latency_note_stop() {
+
+    if (!latencyEnabled.load(std::memory_order_relaxed))
+        return;
+
+    TimePoint expected = 0;
+    latencyStopTime.compare_exchange_strong(expected, now());
+}
+
+void latency_note_bestmove() {
+
+    if (TimePoint t = latencyStopTime.exchange(0))
+        latency_record(LATENCY_STOP_TO_BESTMOVE, now() - t);
+}
+
+// One line per metric: the sample count, the maximum in milliseconds, then the
+// non-empty buckets as 'le<upper bound in ms> <count>' columns. Counters reset
+// on dump, so the output of successive reports can be compared directly.
+std::string latency_report() {
+
+    std::ostringstream ss;
+    for (size_t m = 0; m < LATENCY_NB; ++m)
+    {
+        std::array<int64_t, LatencyBuckets> counts;
+        int64_t                             total = 0;
+        for (int b = 0; b < LatencyBuckets; ++b)
+            total += counts[b] = latencyHist[m][b].exchange(0);
+
+        if (m)
+            ss << '\n';
+        ss << "latency " << LatencyNames[m] << " total " << total << " max "
+           << latencyMax[m].exchange(0);
+
+        for (int b = 0; b < LatencyBuckets; ++b)
+            if (counts[b])
+            {
+                if (b == LatencyBuckets - 1)
+                    ss << " rest " << counts[b];
+                else
+                    ss << " le" << (1LL << b) << ' ' << counts[b];
+            }
+    }
+
+    return ss.str();
+}
+
+
 // Used to serialize access to std::cout
 // to avoid multiple threads writing at the same time.
 std::ostream& operator<<(std::ostream& os, SyncCout sc) {
@@ -30,6 +30,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #define stringify2(x) #x
@@ -74,6 +75,31 @@ void dbg_extremes_of(int64_t value, int slot = 0);
 void dbg_correl_of(int64_t value1, int64_t value2, int slot = 0);
 void dbg_print();
 
+// Named hot-path counters, graduated from the ad-hoc dbg_* slots above. They
+// track production search health (TT probe/hit/overwrite rates, accumulator
+// refreshes vs. incremental updates, movepicker stage transitions, tablebase
+// probes) and are dumped as a single machine-parsable info string on 'stop'.
+// Only 'make profile-stats' builds pay for them; in normal builds the calls
+// compile away entirely.
+enum StatsCounter {
+    STATS_TT_PROBE,
+    STATS_TT_HIT,
+    STATS_TT_OVERWRITE,
+    STATS_ACC_REFRESH,
+    STATS_ACC_UPDATE,
+    STATS_MP_STAGE,
+    STATS_TB_PROBE,
+    STATS_NB
+};
+
+#ifdef ENABLE_STATS
+void stats_count(StatsCounter type);
+void stats_print();
+#else
+inline void stats_count(StatsCounter) {}
+inline void stats_print() {}
+#endif
+
 using TimePoint = std::chrono::milliseconds::rep;  // A value in milliseconds
 static_assert(sizeof(TimePoint) == sizeof(int64_t), "TimePoint should be 64 bits");
 inline TimePoint now() {
@@ -82,6 +108,26 @@ inline TimePoint now() {
       .count();
 }
 
+// Opt-in latency histograms for deployments that run the engine behind a UI
+// with a response-time SLA. Three metrics are tracked: the time from 'go' to
+// the first 'info' line, the duration of each iterative-deepening iteration,
+// and the lag between the stop signal and the 'bestmove' emission. Samples
+// fall into power-of-two millisecond buckets and recording is one relaxed
+// atomic increment; enabled with the 'Latency Stats' option and dumped (and
+// reset) by the 'latencystats' command.
+enum LatencyMetric {
+    LATENCY_FIRST_INFO,
+    LATENCY_ITERATION,
+    LATENCY_STOP_TO_BESTMOVE,
+    LATENCY_NB
+};
+
+void        latency_enable(bool b);
+void        latency_record(LatencyMetric metric, TimePoint duration);
+void        latency_note_stop();      // timestamps the first stop signal of a search
+void        latency_note_bestmove();  // closes the stop -> bestmove interval
+std::string latency_report();
+
 inline std::vector<std::string_view> split(std::string_view s, std::string_view delimiter) {
     std::vector<std::string_view> res;
 
@@ -300,6 +346,23 @@ struct CommandLine {
 
 namespace Utility {
 
+// Stable in-place sort. The search sorts its root moves with this instead of
+// std::stable_sort, because the latter allocates its merge buffer on every
+// call (see AllocGuard in memory.h); the ranges are short and almost sorted,
+// where an insertion sort is the faster choice anyway.
+template<typename Iter>
+void insertion_sort(Iter begin, Iter end) {
+
+    for (Iter it = begin + (begin != end); it < end; ++it)
+    {
+        auto tmp = std::move(*it);
+        Iter j   = it;
+        for (; j > begin && tmp < *(j - 1); --j)
+            *j = std::move(*(j - 1));
+        *j = std::move(tmp);
+    }
+}
+
 template<typename T, typename Predicate>
 void move_to_front(std::vector<T>& vec, Predicate pred) {
     auto it = std::find_if(vec.begin(), vec.end(), pred);
@@ -152,6 +152,24 @@ ExtMove* generate_moves(const Position& pos, ExtMove* moveList, Bitboard target)
 
     static_assert(Pt != KING && Pt != PAWN, "Unsupported piece type in generate_moves()");
 
+    if constexpr (Pt != KNIGHT)
+    {
+        // Slider lookups go through the batched API, which vectorizes the
+        // magic indexing once enough pieces of the type are on the board
+        AttackBatch batch;
+        attacks_bb_batch<Pt>(pos.pieces(Us, Pt), pos.pieces(), batch);
+
+        for (int i = 0; i < batch.size; ++i)
+        {
+            Bitboard b = batch.attacks[i] & target;
+
+            while (b)
+                *moveList++ = Move(batch.from[i], pop_lsb(b));
+        }
+
+        return moveList;
+    }
+
     Bitboard bb = pos.pieces(Us, Pt);
 
     while (bb)
@@ -167,7 +185,7 @@ ExtMove* generate_moves(const Position& pos, ExtMove* moveList, Bitboard target)
 }
 
 
-template<Color Us, GenType Type>
+template<Color Us, GenType Type, bool Knights, bool Bishops, bool Rooks, bool Queens>
 ExtMove* generate_all(const Position& pos, ExtMove* moveList) {
 
     static_assert(Type != LEGAL, "Unsupported type in generate_all()");
@@ -184,14 +202,32 @@ ExtMove* generate_all(const Position& pos, ExtMove* moveList) {
                                       : ~pos.pieces();  // QUIETS
 
         moveList = generate_pawn_moves<Us, Type>(pos, moveList, target);
-        moveList = generate_moves<Us, KNIGHT>(pos, moveList, target);
-        moveList = generate_moves<Us, BISHOP>(pos, moveList, target);
-        moveList = generate_moves<Us, ROOK>(pos, moveList, target);
-        moveList = generate_moves<Us, QUEEN>(pos, moveList, target);
+        if constexpr (Knights)
+            moveList = generate_moves<Us, KNIGHT>(pos, moveList, target);
+        if constexpr (Bishops)
+            moveList = generate_moves<Us, BISHOP>(pos, moveList, target);
+        if constexpr (Rooks)
+            moveList = generate_moves<Us, ROOK>(pos, moveList, target);
+        if constexpr (Queens)
+            moveList = generate_moves<Us, QUEEN>(pos, moveList, target);
     }
 
     Bitboard b = attacks_bb<KING>(ksq) & (Type == EVASIONS ? ~pos.pieces(Us) : target);
 
+    if constexpr (Type == EVASIONS)
+    {
+        // Squares on a slider checker's ray stay attacked once the king
+        // steps along it, so mask them out up front (the checker square
+        // itself is kept, capturing it may be legal). Most surviving king
+        // moves then pass the later legality check.
+        Bitboard sliders = pos.checkers() & ~pos.pieces(KNIGHT, PAWN);
+        while (sliders)
+        {
+            Square s = pop_lsb(sliders);
+            b &= ~(line_bb(s, ksq) ^ s);
+        }
+    }
+
     while (b)
         *moveList++ = Move(ksq, pop_lsb(b));
 
@@ -203,6 +239,33 @@ ExtMove* generate_all(const Position& pos, ExtMove* moveList) {
     return moveList;
 }
 
+
+// Picks the generate_all() variant matching the side to move's material, so
+// that in the common endgame configurations the loops over absent piece types
+// are dead-code-eliminated instead of iterating empty piece lists at every
+// node. Only the signatures that dominate endgame workloads get their own
+// instantiation; anything else falls through to the full generator.
+template<Color Us, GenType Type>
+ExtMove* generate_all(const Position& pos, ExtMove* moveList) {
+
+    if (!pos.count<QUEEN>(Us))
+    {
+        if (!pos.count<KNIGHT>(Us) && !pos.count<BISHOP>(Us))
+            return pos.count<ROOK>(Us)
+                   ? generate_all<Us, Type, false, false, true, false>(pos, moveList)  // rook ending
+                   : generate_all<Us, Type, false, false, false, false>(pos,
+                                                                        moveList);  // pawn ending
+
+        if (!pos.count<ROOK>(Us))
+            return generate_all<Us, Type, true, true, false, false>(pos,
+                                                                    moveList);  // minors only
+
+        return generate_all<Us, Type, true, true, true, false>(pos, moveList);  // queenless
+    }
+
+    return generate_all<Us, Type, true, true, true, true>(pos, moveList);
+}
+
 }  // namespace
 
 
@@ -243,14 +306,103 @@ ExtMove* generate<LEGAL>(const Position& pos, ExtMove* moveList) {
 
     moveList =
       pos.checkers() ? generate<EVASIONS>(pos, moveList) : generate<NON_EVASIONS>(pos, moveList);
+
+    // Precompute once the squares attacked by the opponent, with our king
+    // removed from the occupancy so that squares shadowed by it still count
+    // as attacked. Ordinary king moves are then validated with a single mask
+    // test, and a pinned piece's move with an alignment test against the pin
+    // line, leaving a Position::legal() call only for the rare en passant
+    // and castling moves.
+    const Color    them = ~us;
+    const Bitboard occ  = pos.pieces() ^ ksq;
+
+    Bitboard danger = them == WHITE ? pawn_attacks_bb<WHITE>(pos.pieces(WHITE, PAWN))
+                                    : pawn_attacks_bb<BLACK>(pos.pieces(BLACK, PAWN));
+    danger |= attacks_bb<KING>(pos.square<KING>(them));
+
+    Bitboard b = pos.pieces(them, KNIGHT);
+    while (b)
+        danger |= attacks_bb<KNIGHT>(pop_lsb(b));
+
+    // Diagonal and orthogonal rays in two batched passes: with the queens
+    // counted in both, middlegame positions fill enough lanes to vectorize
+    AttackBatch sliders;
+    attacks_bb_batch<BISHOP>(pos.pieces(them, BISHOP, QUEEN), occ, sliders);
+    for (int i = 0; i < sliders.size; ++i)
+        danger |= sliders.attacks[i];
+    attacks_bb_batch<ROOK>(pos.pieces(them, ROOK, QUEEN), occ, sliders);
+    for (int i = 0; i < sliders.size; ++i)
+        danger |= sliders.attacks[i];
+
     while (cur != moveList)
-        if (((pinned & cur->from_sq()) || cur->from_sq() == ksq || cur->type_of() == EN_PASSANT)
-            && !pos.legal(*cur))
-            *cur = *(--moveList);
+    {
+        const Square from = cur->from_sq();
+
+        bool keep;
+        if (cur->type_of() == EN_PASSANT || cur->type_of() == CASTLING)
+            keep = pos.legal(*cur);
+        else if (from == ksq)
+            keep = !(danger & cur->to_sq());
+        else if (pinned & from)
+            keep = aligned(from, cur->to_sq(), ksq);
         else
+            keep = true;
+
+        if (keep)
             ++cur;
+        else
+            *cur = *(--moveList);
+    }
 
     return moveList;
 }
 
+
+// Tests whether the side to move has any legal move without building and
+// validating a complete list. When in check, king moves are tried first from
+// the slider-safe mask and the blocking and capturing evasions only when
+// those fail, so mate detection usually settles on the first candidate; out
+// of check the first pseudo-legal move is almost always the answer.
+bool has_legal_moves(const Position& pos) {
+
+    const Color  us  = pos.side_to_move();
+    const Square ksq = pos.square<KING>(us);
+
+    ExtMove list[MAX_MOVES];
+
+    if (pos.checkers())
+    {
+        Bitboard b = attacks_bb<KING>(ksq) & ~pos.pieces(us);
+
+        Bitboard sliders = pos.checkers() & ~pos.pieces(KNIGHT, PAWN);
+        while (sliders)
+        {
+            Square s = pop_lsb(sliders);
+            b &= ~(line_bb(s, ksq) ^ s);
+        }
+
+        while (b)
+            if (pos.legal(Move(ksq, pop_lsb(b))))
+                return true;
+
+        // In double check only a king move could have helped
+        if (more_than_one(pos.checkers()))
+            return false;
+
+        ExtMove* end = generate<EVASIONS>(pos, list);
+        for (ExtMove* m = list; m != end; ++m)
+            if (m->from_sq() != ksq && pos.legal(*m))
+                return true;
+
+        return false;
+    }
+
+    ExtMove* end = generate<NON_EVASIONS>(pos, list);
+    for (ExtMove* m = list; m != end; ++m)
+        if (pos.legal(*m))
+            return true;
+
+    return false;
+}
+
 }  // namespace Stockfish
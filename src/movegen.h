@@ -51,6 +51,10 @@ inline bool operator<(const ExtMove& f, const ExtMove& s) { return f.value < s.v
 template<GenType>
 ExtMove* generate(const Position& pos, ExtMove* moveList);
 
+// Tests whether the side to move has at least one legal move, short-circuiting
+// on the first one found instead of building the complete list; see movegen.cpp
+bool has_legal_moves(const Position& pos);
+
 // The MoveList struct wraps the generate() function and returns a convenient
 // list of moves. Using MoveList is sometimes preferable to directly calling
 // the lower level generate() function.
@@ -21,12 +21,42 @@
 #include <cassert>
 #include <limits>
 
+#if defined(USE_AVX2)
+    #include <immintrin.h>
+#endif
+
 #include "bitboard.h"
 #include "misc.h"
 #include "position.h"
 
 namespace Stockfish {
 
+#if defined(USE_AVX2)
+
+// Gathers 8 packed 16-bit stats (see Stats in history.h). There is no 16-bit
+// gather before AVX-512, so the containing aligned 4-byte pair is gathered and
+// the right half selected by index parity, which keeps every access inside
+// the table. The caller handles table staleness, see score().
+static inline __m256i gather_stats16(const std::int16_t* base, __m256i indices) {
+    __m256i pairs = _mm256_i32gather_epi32(reinterpret_cast<const int*>(base),
+                                           _mm256_srli_epi32(indices, 1), 4);
+    __m256i hi    = _mm256_srai_epi32(pairs, 16);
+    __m256i lo    = _mm256_srai_epi32(_mm256_slli_epi32(pairs, 16), 16);
+    __m256i odd   = _mm256_cmpeq_epi32(_mm256_and_si256(indices, _mm256_set1_epi32(1)),
+                                       _mm256_set1_epi32(1));
+    return _mm256_blendv_epi8(lo, hi, odd);
+}
+
+// Truncating division by 3, matching the scalar x / 3 for |x| <= 30000
+static inline __m256i div3_epi32(__m256i x) {
+    __m256i q =
+      _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_abs_epi32(x), _mm256_set1_epi32(21846)), 16);
+    __m256i neg = _mm256_srai_epi32(x, 31);
+    return _mm256_sub_epi32(_mm256_xor_si256(q, neg), neg);
+}
+
+#endif
+
 namespace {
 
 enum Stages {
@@ -86,6 +116,7 @@ MovePicker::MovePicker(const Position&              p,
                        const CapturePieceToHistory* cph,
                        const PieceToHistory**       ch,
                        const PawnHistory*           ph,
+                       PawnStructureCache*          pc,
                        int                          pl) :
     pos(p),
     mainHistory(mh),
@@ -93,6 +124,7 @@ MovePicker::MovePicker(const Position&              p,
     captureHistory(cph),
     continuationHistory(ch),
     pawnHistory(ph),
+    pawnCache(pc),
     ttMove(ttm),
     depth(d),
     ply(pl) {
@@ -142,6 +174,87 @@ void MovePicker::score() {
                          | (pos.pieces(us, KNIGHT, BISHOP) & threatenedByPawn);
     }
 
+    // The pure table terms of quiet scoring are accumulated in a separate
+    // gather-friendly pass: all indices are computable up front, so 8 moves are
+    // scored per iteration where gathers are available, and the conditional
+    // bonuses below stay scalar.
+    [[maybe_unused]] int histSum[MAX_MOVES];
+    if constexpr (Type == QUIETS)
+    {
+        const Color us      = pos.side_to_move();
+        const int   pawnIdx = pawn_structure_index(pos);
+        const int   n       = int(endMoves - cur);
+
+        // Table staleness resolves once per node here instead of once per
+        // entry: a fresh table is a plain packed int16 array, and a stale one
+        // contributes its fill value as a constant (see Stats in history.h).
+        const std::int16_t* mh = mainHistory->flat() + us * SQUARE_NB * SQUARE_NB;
+        const std::int16_t* ph = pawnHistory->flat() + pawnIdx * PIECE_NB * SQUARE_NB;
+        const bool          mhFresh = mainHistory->fresh();
+        const bool          phFresh = pawnHistory->fresh();
+
+        const std::int16_t* ch[6];
+        bool                chFresh[6];
+        for (int k = 0; k < 6; ++k)
+        {
+            ch[k]      = continuationHistory[k]->flat();
+            chFresh[k] = continuationHistory[k]->fresh();
+        }
+
+        int32_t idxFT[MAX_MOVES], idxPT[MAX_MOVES];
+        for (int i = 0; i < n; ++i)
+        {
+            idxFT[i] = cur[i].from_to();
+            idxPT[i] = int(pos.moved_piece(cur[i])) * SQUARE_NB + int(cur[i].to_sq());
+        }
+
+        // Stale tables stand in with their fill value, so the stale-read
+        // path scores exactly like a freshly initialized table would
+        constexpr int mhFV = ButterflyHistory::FillValue;
+        constexpr int phFV = PawnHistory::FillValue;
+        constexpr int chFV = PieceToHistory::FillValue;
+
+        auto scalar_hist = [&](int i) {
+            return 2 * (mhFresh ? mh[idxFT[i]] : mhFV) + 2 * (phFresh ? ph[idxPT[i]] : phFV)
+                 + (chFresh[0] ? ch[0][idxPT[i]] : chFV) + (chFresh[1] ? ch[1][idxPT[i]] : chFV)
+                 + (chFresh[2] ? ch[2][idxPT[i]] : chFV) + (chFresh[3] ? ch[3][idxPT[i]] : chFV)
+                 + (chFresh[4] ? ch[4][idxPT[i]] : chFV) / 3
+                 + (chFresh[5] ? ch[5][idxPT[i]] : chFV);
+        };
+
+        int i = 0;
+#if defined(USE_AVX2)
+        for (; i + 8 <= n; i += 8)
+        {
+            __m256i ft = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&idxFT[i]));
+            __m256i pt = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&idxPT[i]));
+
+            auto term = [](const std::int16_t* base, bool fresh, int fv, __m256i idx) {
+                return fresh ? gather_stats16(base, idx) : _mm256_set1_epi32(fv);
+            };
+
+            __m256i v = _mm256_slli_epi32(term(mh, mhFresh, mhFV, ft), 1);
+            v = _mm256_add_epi32(v, _mm256_slli_epi32(term(ph, phFresh, phFV, pt), 1));
+            v = _mm256_add_epi32(v, term(ch[0], chFresh[0], chFV, pt));
+            v = _mm256_add_epi32(v, term(ch[1], chFresh[1], chFV, pt));
+            v = _mm256_add_epi32(v, term(ch[2], chFresh[2], chFV, pt));
+            v = _mm256_add_epi32(v, term(ch[3], chFresh[3], chFV, pt));
+            v = _mm256_add_epi32(v, div3_epi32(term(ch[4], chFresh[4], chFV, pt)));
+            v = _mm256_add_epi32(v, term(ch[5], chFresh[5], chFV, pt));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&histSum[i]), v);
+        }
+#endif
+        for (; i < n; ++i)
+            histSum[i] = scalar_hist(i);
+    }
+
+    // Memoized pawn-structure masks for the positional bonuses below
+    [[maybe_unused]] const PawnStructureCache::Entry* pawnEntry = nullptr;
+    if constexpr (Type == QUIETS)
+        if (pawnCache)
+            pawnEntry = &pawnCache->probe(pos);
+
     for (auto& m : *this)
         if constexpr (Type == CAPTURES)
             m.value =
@@ -155,15 +268,8 @@ void MovePicker::score() {
             Square    from = m.from_sq();
             Square    to   = m.to_sq();
 
-            // histories
-            m.value = 2 * (*mainHistory)[pos.side_to_move()][m.from_to()];
-            m.value += 2 * (*pawnHistory)[pawn_structure_index(pos)][pc][to];
-            m.value += (*continuationHistory[0])[pc][to];
-            m.value += (*continuationHistory[1])[pc][to];
-            m.value += (*continuationHistory[2])[pc][to];
-            m.value += (*continuationHistory[3])[pc][to];
-            m.value += (*continuationHistory[4])[pc][to] / 3;
-            m.value += (*continuationHistory[5])[pc][to];
+            // histories, accumulated in the batched pass above
+            m.value = histSum[&m - cur];
 
             // bonus for checks
             m.value += bool(pos.check_squares(pt) & to) * 16384;
@@ -180,6 +286,18 @@ void MovePicker::score() {
                         : pt == ROOK && bool(to & threatenedByMinor) ? 24335
                                                                      : 0);
 
+            // bonus for pushing a passed pawn and for rook moves to open files
+            if (pawnEntry)
+            {
+                Color us = pos.side_to_move();
+
+                if (pt == PAWN && (pawnEntry->passedPawns[us] & from))
+                    m.value += 12850;
+                else if (pt == ROOK && (pawnEntry->openFiles & to)
+                         && !(pawnEntry->openFiles & from))
+                    m.value += 6150;
+            }
+
             if (ply < LOW_PLY_HISTORY_SIZE)
                 m.value += 8 * (*lowPlyHistory)[ply][m.from_to()] / (1 + 2 * ply);
         }
@@ -223,6 +341,7 @@ top:
     case QSEARCH_TT :
     case PROBCUT_TT :
         ++stage;
+        stats_count(STATS_MP_STAGE);
         return ttMove;
 
     case CAPTURE_INIT :
@@ -234,6 +353,7 @@ top:
         score<CAPTURES>();
         partial_insertion_sort(cur, endMoves, std::numeric_limits<int>::min());
         ++stage;
+        stats_count(STATS_MP_STAGE);
         goto top;
 
     case GOOD_CAPTURE :
@@ -245,6 +365,7 @@ top:
             return *(cur - 1);
 
         ++stage;
+        stats_count(STATS_MP_STAGE);
         [[fallthrough]];
 
     case QUIET_INIT :
@@ -258,6 +379,7 @@ top:
         }
 
         ++stage;
+        stats_count(STATS_MP_STAGE);
         [[fallthrough]];
 
     case GOOD_QUIET :
@@ -275,6 +397,7 @@ top:
         endMoves = endBadCaptures;
 
         ++stage;
+        stats_count(STATS_MP_STAGE);
         [[fallthrough]];
 
     case BAD_CAPTURE :
@@ -286,6 +409,7 @@ top:
         endMoves = endBadQuiets;
 
         ++stage;
+        stats_count(STATS_MP_STAGE);
         [[fallthrough]];
 
     case BAD_QUIET :
@@ -301,6 +425,7 @@ top:
         score<EVASIONS>();
         partial_insertion_sort(cur, endMoves, std::numeric_limits<int>::min());
         ++stage;
+        stats_count(STATS_MP_STAGE);
         [[fallthrough]];
 
     case EVASION :
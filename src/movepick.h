@@ -21,6 +21,7 @@
 
 #include "history.h"
 #include "movegen.h"
+#include "pawncache.h"
 #include "types.h"
 
 namespace Stockfish {
@@ -46,6 +47,7 @@ class MovePicker {
                const CapturePieceToHistory*,
                const PieceToHistory**,
                const PawnHistory*,
+               PawnStructureCache*,
                int);
     MovePicker(const Position&, Move, int, const CapturePieceToHistory*);
     Move next_move();
@@ -65,6 +67,7 @@ class MovePicker {
     const CapturePieceToHistory* captureHistory;
     const PieceToHistory**       continuationHistory;
     const PawnHistory*           pawnHistory;
+    PawnStructureCache*          pawnCache = nullptr;
     Move                         ttMove;
     ExtMove *                    cur, *endMoves, *endBadCaptures, *beginBadQuiets, *endBadQuiets;
     int                          stage;
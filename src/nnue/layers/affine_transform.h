@@ -21,6 +21,7 @@
 #ifndef NNUE_LAYERS_AFFINE_TRANSFORM_H_INCLUDED
 #define NNUE_LAYERS_AFFINE_TRANSFORM_H_INCLUDED
 
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 
@@ -293,6 +294,129 @@ class AffineTransform {
 #endif
     }
 
+    // Forward propagation with the clamp of a following ClippedReLU fused in.
+    // The accumulators are packed and clamped while still in registers, so the
+    // int32 outputs are never stored and re-read between the two layers.
+    void propagate_clipped(const InputType* input, std::uint8_t* output) const {
+
+#ifdef ENABLE_SEQ_OPT
+        if constexpr (OutputDimensions > 1 && OutputDimensions % 32 == 0)
+        {
+    #if defined(USE_AVX512)
+            using vec_t = __m512i;
+        #define vec_set_32 _mm512_set1_epi32
+        #define vec_add_dpbusd_32 Simd::m512_add_dpbusd_epi32
+    #elif defined(USE_AVX2)
+            using vec_t = __m256i;
+        #define vec_set_32 _mm256_set1_epi32
+        #define vec_add_dpbusd_32 Simd::m256_add_dpbusd_epi32
+    #elif defined(USE_SSSE3)
+            using vec_t = __m128i;
+        #define vec_set_32 _mm_set1_epi32
+        #define vec_add_dpbusd_32 Simd::m128_add_dpbusd_epi32
+    #elif defined(USE_NEON_DOTPROD)
+            using vec_t = int32x4_t;
+        #define vec_set_32 vdupq_n_s32
+        #define vec_add_dpbusd_32(acc, a, b) \
+            Simd::dotprod_m128_add_dpbusd_epi32(acc, vreinterpretq_s8_s32(a), \
+                                                vreinterpretq_s8_s32(b))
+    #endif
+
+            static constexpr IndexType OutputSimdWidth = sizeof(vec_t) / sizeof(OutputType);
+
+            static_assert(OutputDimensions % OutputSimdWidth == 0);
+
+            constexpr IndexType NumChunks = ceil_to_multiple<IndexType>(InputDimensions, 8) / 4;
+            constexpr IndexType NumRegs   = OutputDimensions / OutputSimdWidth;
+
+            const auto   input32 = reinterpret_cast<const std::int32_t*>(input);
+            const vec_t* biasvec = reinterpret_cast<const vec_t*>(biases);
+            vec_t        acc[NumRegs];
+            for (IndexType k = 0; k < NumRegs; ++k)
+                acc[k] = biasvec[k];
+
+            for (IndexType i = 0; i < NumChunks; ++i)
+            {
+                const vec_t in0 = vec_set_32(input32[i]);
+                const auto  col0 =
+                  reinterpret_cast<const vec_t*>(&weights[i * OutputDimensions * 4]);
+
+                for (IndexType k = 0; k < NumRegs; ++k)
+                    vec_add_dpbusd_32(acc[k], in0, col0[k]);
+            }
+
+            // The pack sequences below mirror ClippedReLU::propagate(), applied
+            // to the accumulators instead of a reloaded buffer.
+    #if defined(USE_AVX512)
+            const __m256i Offsets = _mm256_set_epi32(7, 3, 6, 2, 5, 1, 4, 0);
+            const auto    out     = reinterpret_cast<__m256i*>(output);
+            for (IndexType k = 0; k < NumRegs; k += 2)
+            {
+                const __m256i words0 =
+                  _mm256_srli_epi16(_mm256_packus_epi32(_mm512_castsi512_si256(acc[k]),
+                                                        _mm512_extracti64x4_epi64(acc[k], 1)),
+                                    WeightScaleBits);
+                const __m256i words1 =
+                  _mm256_srli_epi16(_mm256_packus_epi32(_mm512_castsi512_si256(acc[k + 1]),
+                                                        _mm512_extracti64x4_epi64(acc[k + 1], 1)),
+                                    WeightScaleBits);
+                out[k / 2] = _mm256_permutevar8x32_epi32(_mm256_packs_epi16(words0, words1),
+                                                         Offsets);
+            }
+    #elif defined(USE_AVX2)
+            const __m256i Offsets = _mm256_set_epi32(7, 3, 6, 2, 5, 1, 4, 0);
+            const auto    out     = reinterpret_cast<__m256i*>(output);
+            for (IndexType k = 0; k < NumRegs; k += 4)
+            {
+                const __m256i words0 =
+                  _mm256_srli_epi16(_mm256_packus_epi32(acc[k], acc[k + 1]), WeightScaleBits);
+                const __m256i words1 =
+                  _mm256_srli_epi16(_mm256_packus_epi32(acc[k + 2], acc[k + 3]), WeightScaleBits);
+                out[k / 4] = _mm256_permutevar8x32_epi32(_mm256_packs_epi16(words0, words1),
+                                                         Offsets);
+            }
+    #elif defined(USE_SSSE3)
+            // SSSE3 lacks _mm_packus_epi32, so pack signed and clamp the
+            // negative bytes to zero afterwards, as in the SSE2 ClippedReLU.
+            const __m128i k0x80s = _mm_set1_epi8(-128);
+            const auto    out    = reinterpret_cast<__m128i*>(output);
+            for (IndexType k = 0; k < NumRegs; k += 4)
+            {
+                const __m128i words0 =
+                  _mm_srai_epi16(_mm_packs_epi32(acc[k], acc[k + 1]), WeightScaleBits);
+                const __m128i words1 =
+                  _mm_srai_epi16(_mm_packs_epi32(acc[k + 2], acc[k + 3]), WeightScaleBits);
+                const __m128i packedbytes = _mm_packs_epi16(words0, words1);
+                out[k / 4] = _mm_subs_epi8(_mm_adds_epi8(packedbytes, k0x80s), k0x80s);
+            }
+    #elif defined(USE_NEON_DOTPROD)
+            const int8x8_t Zero = {0};
+            const auto     out  = reinterpret_cast<int8x8_t*>(output);
+            for (IndexType k = 0; k < NumRegs; k += 2)
+            {
+                int16x8_t  shifted;
+                const auto pack = reinterpret_cast<int16x4_t*>(&shifted);
+                pack[0]         = vqshrn_n_s32(acc[k], WeightScaleBits);
+                pack[1]         = vqshrn_n_s32(acc[k + 1], WeightScaleBits);
+                out[k / 2]      = vmax_s8(vqmovn_s16(shifted), Zero);
+            }
+    #endif
+
+    #undef vec_set_32
+    #undef vec_add_dpbusd_32
+
+            return;
+        }
+#endif  // ENABLE_SEQ_OPT
+
+        // Other architectures and dimensions: propagate into a local buffer
+        // and clamp it while it is still in cache.
+        alignas(CacheLineSize) OutputBuffer raw;
+        propagate(input, raw);
+        for (IndexType i = 0; i < OutputDimensions; ++i)
+            output[i] = static_cast<std::uint8_t>(std::clamp(raw[i] >> WeightScaleBits, 0, 127));
+    }
+
    private:
     using BiasType   = OutputType;
     using WeightType = std::int8_t;
@@ -18,6 +18,7 @@
 
 #include "network.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
@@ -85,6 +86,29 @@ EmbeddedNNUE get_embedded(EmbeddedNNUEType type) {
 
 namespace Stockfish::Eval::NNUE {
 
+// Raw parameter dumps are the in-memory images of the already parsed and
+// permuted parameters, written out for fast startup (see save_raw). The layout
+// depends on the SIMD flavour the build permutes its weights for, so a dump
+// carries a tag of that flavour and is rejected by any other build.
+constexpr char RawMagic[8] = {'S', 'F', 'R', 'A', 'W', 'N', 'E', 'T'};
+
+constexpr std::uint32_t RawVersion = 1;
+
+constexpr std::uint32_t RawSimdTag =
+#if defined(USE_AVX512)
+  5;
+#elif defined(USE_AVX2)
+  4;
+#elif defined(USE_SSSE3)
+  3;
+#elif defined(USE_SSE2)
+  2;
+#elif defined(USE_NEON)
+  1;
+#else
+  0;
+#endif
+
 
 namespace Detail {
 
@@ -236,6 +260,16 @@ Network<Arch, Transformer>::evaluate(const Position&                         pos
 }
 
 
+template<typename Arch, typename Transformer>
+Value Network<Arch, Transformer>::evaluate_psqt(
+  const Position& pos, AccumulatorCaches::Cache<FTDimensions>* cache) const {
+
+    const int bucket = (pos.count<ALL_PIECES>() - 1) / 4;
+    return static_cast<Value>(featureTransformer->transform_psqt(pos, cache, bucket)
+                              / OutputScale);
+}
+
+
 template<typename Arch, typename Transformer>
 void Network<Arch, Transformer>::verify(std::string                                  evalfilePath,
                                         const std::function<void(std::string_view)>& f) const {
@@ -380,12 +414,36 @@ bool Network<Arch, Transformer>::save(std::ostream&      stream,
 }
 
 
+template<typename Arch, typename Transformer>
+bool Network<Arch, Transformer>::save_raw(const std::optional<std::string>& filename) const {
+    // Unlike save(), never fall back to the default net name: that would
+    // overwrite a standard .nnue file with a raw dump.
+    const std::string actualFilename =
+      filename.has_value() ? filename.value() : evalFile.current + ".raw";
+
+    std::ofstream stream(actualFilename, std::ios_base::binary);
+    bool          saved = write_raw_parameters(stream, evalFile.netDescription);
+
+    sync_cout << (saved ? "Network saved successfully to " + actualFilename
+                        : "Failed to export a net")
+              << sync_endl;
+    return saved;
+}
+
+
 template<typename Arch, typename Transformer>
 std::optional<std::string> Network<Arch, Transformer>::load(std::istream& stream) {
     initialize();
     std::string description;
 
-    return read_parameters(stream, description) ? std::make_optional(description) : std::nullopt;
+    // A raw parameter dump (see save_raw) is recognized by its magic, whose
+    // first byte cannot start a standard .nnue file.
+    const bool raw = stream.peek() == RawMagic[0];
+
+    const bool ok =
+      raw ? read_raw_parameters(stream, description) : read_parameters(stream, description);
+
+    return ok ? std::make_optional(description) : std::nullopt;
 }
 
 
@@ -454,6 +512,61 @@ bool Network<Arch, Transformer>::write_parameters(std::ostream&      stream,
     return bool(stream);
 }
 
+template<typename Arch, typename Transformer>
+bool Network<Arch, Transformer>::read_raw_parameters(std::istream& stream,
+                                                     std::string&  netDescription) const {
+    static_assert(std::is_trivially_copyable_v<Transformer>);
+    static_assert(std::is_trivially_copyable_v<Arch>);
+
+    char magic[sizeof(RawMagic)];
+    stream.read(magic, sizeof(magic));
+    if (!stream || !std::equal(std::begin(magic), std::end(magic), std::begin(RawMagic)))
+        return false;
+
+    if (read_little_endian<std::uint32_t>(stream) != RawVersion
+        || read_little_endian<std::uint32_t>(stream) != Network::hash
+        || read_little_endian<std::uint32_t>(stream) != RawSimdTag
+        || read_little_endian<std::uint64_t>(stream) != sizeof(Transformer)
+        || read_little_endian<std::uint64_t>(stream) != sizeof(Arch)
+        || read_little_endian<std::uint32_t>(stream) != LayerStacks || !stream)
+        return false;
+
+    const auto size = read_little_endian<std::uint32_t>(stream);
+    if (!stream)
+        return false;
+    netDescription.resize(size);
+    stream.read(&netDescription[0], size);
+
+    // The parameters were dumped after parsing and permutation, so they can be
+    // read back in bulk, straight into place.
+    stream.read(reinterpret_cast<char*>(featureTransformer.get()), sizeof(Transformer));
+    for (std::size_t i = 0; i < LayerStacks; ++i)
+        stream.read(reinterpret_cast<char*>(&network[i]), sizeof(Arch));
+
+    return stream && stream.peek() == std::ios::traits_type::eof();
+}
+
+
+template<typename Arch, typename Transformer>
+bool Network<Arch, Transformer>::write_raw_parameters(std::ostream&      stream,
+                                                      const std::string& netDescription) const {
+    stream.write(RawMagic, sizeof(RawMagic));
+    write_little_endian<std::uint32_t>(stream, RawVersion);
+    write_little_endian<std::uint32_t>(stream, Network::hash);
+    write_little_endian<std::uint32_t>(stream, RawSimdTag);
+    write_little_endian<std::uint64_t>(stream, sizeof(Transformer));
+    write_little_endian<std::uint64_t>(stream, sizeof(Arch));
+    write_little_endian<std::uint32_t>(stream, LayerStacks);
+    write_little_endian<std::uint32_t>(stream, std::uint32_t(netDescription.size()));
+    stream.write(&netDescription[0], netDescription.size());
+
+    stream.write(reinterpret_cast<const char*>(featureTransformer.get()), sizeof(Transformer));
+    for (std::size_t i = 0; i < LayerStacks; ++i)
+        stream.write(reinterpret_cast<const char*>(&network[i]), sizeof(Arch));
+
+    return bool(stream);
+}
+
 // Explicit template instantiation
 
 template class Network<
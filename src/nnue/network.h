@@ -63,9 +63,21 @@ class Network {
     void load(const std::string& rootDirectory, std::string evalfilePath);
     bool save(const std::optional<std::string>& filename) const;
 
+    // Exports the fully parsed and SIMD-permuted in-memory parameters as a raw
+    // image. load() recognizes such a file by its magic and reads it back with
+    // a couple of bulk reads, skipping the per-parameter parsing on startup.
+    // The dump is specific to this build's weight layout and is validated
+    // against it when loaded.
+    bool save_raw(const std::optional<std::string>& filename) const;
+
     NetworkOutput evaluate(const Position&                         pos,
                            AccumulatorCaches::Cache<FTDimensions>* cache) const;
 
+    // Only the PSQT half of evaluate(), read straight from the accumulator
+    // without propagating through the layer stack
+    Value evaluate_psqt(const Position&                         pos,
+                        AccumulatorCaches::Cache<FTDimensions>* cache) const;
+
 
     void hint_common_access(const Position&                         pos,
                             AccumulatorCaches::Cache<FTDimensions>* cache) const;
@@ -89,6 +101,9 @@ class Network {
     bool read_parameters(std::istream&, std::string&) const;
     bool write_parameters(std::ostream&, const std::string&) const;
 
+    bool read_raw_parameters(std::istream&, std::string&) const;
+    bool write_raw_parameters(std::ostream&, const std::string&) const;
+
     // Input feature converter
     LargePagePtr<Transformer> featureTransformer;
 
@@ -21,6 +21,8 @@
 #ifndef NNUE_ACCUMULATOR_H_INCLUDED
 #define NNUE_ACCUMULATOR_H_INCLUDED
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 
 #include "nnue_architecture.h"
@@ -78,11 +80,36 @@ struct AccumulatorCaches {
             for (auto& entries1D : entries)
                 for (auto& entry : entries1D)
                     entry.clear(network.featureTransformer->biases);
+
+            for (auto& locks1D : locks)
+                for (auto& lock : locks1D)
+                    lock.store(false, std::memory_order_relaxed);
+        }
+
+        // Tries to take exclusive ownership of the [sq][perspective] entry of
+        // the node-shared cache this one is attached to. Fails instead of
+        // spinning when another thread holds the entry; the caller then falls
+        // back to its private entry, so contention only costs locality.
+        bool try_lock_shared(Square sq, Color perspective) {
+            return shared != nullptr
+                && !shared->locks[sq][perspective].exchange(true, std::memory_order_acquire);
+        }
+
+        void unlock_shared(Square sq, Color perspective) {
+            shared->locks[sq][perspective].store(false, std::memory_order_release);
         }
 
         std::array<Entry, COLOR_NB>& operator[](Square sq) { return entries[sq]; }
 
         std::array<std::array<Entry, COLOR_NB>, SQUARE_NB> entries;
+
+        // Per-entry locks, only used when this instance is the node-shared
+        // cache of one or more threads; a private cache needs no locking.
+        std::array<std::array<std::atomic<bool>, COLOR_NB>, SQUARE_NB> locks{};
+
+        // Node-shared cache serving the same king-bucket layout, or nullptr
+        // when sharing is disabled.
+        Cache* shared = nullptr;
     };
 
     template<typename Networks>
@@ -91,6 +118,14 @@ struct AccumulatorCaches {
         small.clear(networks.small);
     }
 
+    // Attaches (or detaches, with nullptr) a cache shared by all threads on
+    // the same NUMA node, so refreshes can reuse entries warmed by siblings
+    // searching overlapping trees.
+    void set_shared(AccumulatorCaches* sharedCaches) {
+        big.shared   = sharedCaches ? &sharedCaches->big : nullptr;
+        small.shared = sharedCaches ? &sharedCaches->small : nullptr;
+    }
+
     Cache<TransformedFeatureDimensionsBig>   big;
     Cache<TransformedFeatureDimensionsSmall> small;
 };
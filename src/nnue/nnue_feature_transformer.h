@@ -26,9 +26,11 @@
 #include <cstdint>
 #include <cstring>
 #include <iosfwd>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
+#include "../misc.h"
 #include "../position.h"
 #include "../types.h"
 #include "nnue_accumulator.h"
@@ -41,6 +43,25 @@ using BiasType       = std::int16_t;
 using WeightType     = std::int16_t;
 using PSQTWeightType = std::int32_t;
 
+// Storage type of the feature transformer weights. The reduced-precision
+// throughput build (fast8=yes, or an ARCH with the -fast8 suffix) keeps them
+// as int8, saturated to [-127, 127] at load time, halving the table that
+// dominates the network's memory footprint. Columns are widened back to int16
+// in registers on every use, so the accumulation itself stays exact int16 and
+// incremental add/sub updates remain reversible; only weights outside the
+// int8 range lose precision, which for the published nets is a rare, small
+// clamp. Accumulators, biases and the PSQT tables are unaffected.
+#if defined(NNUE_FAST8)
+using StoredWeightType = std::int8_t;
+#else
+using StoredWeightType = std::int16_t;
+#endif
+
+// The int16 path bakes the 2x scale required by the mulhi trick in
+// transform() into the stored values, see scale_weights(). The int8 path
+// stores unscaled weights and applies the factor while widening instead.
+constexpr int StoredWeightScale = sizeof(StoredWeightType) == 1 ? 2 : 1;
+
 // If vector instructions are enabled, we update and refresh the
 // accumulator tile by tile such that each tile fits in the CPU's
 // vector registers.
@@ -64,12 +85,24 @@ using psqt_vec_t = __m256i;
     #define vec_slli_16(a, b) _mm512_slli_epi16(a, b)
     // Inverse permuted at load time
     #define vec_packus_16(a, b) _mm512_packus_epi16(a, b)
+    // Widening load of one register's worth of int8 weights, including the
+    // 2x scale the int16 path applies at load time
+    #define vec_load_w8(a) \
+        _mm512_slli_epi16( \
+          _mm512_cvtepi8_epi16(_mm256_load_si256(reinterpret_cast<const __m256i*>(a))), 1)
     #define vec_load_psqt(a) _mm256_load_si256(a)
     #define vec_store_psqt(a, b) _mm256_store_si256(a, b)
     #define vec_add_psqt_32(a, b) _mm256_add_epi32(a, b)
     #define vec_sub_psqt_32(a, b) _mm256_sub_epi32(a, b)
     #define vec_zero_psqt() _mm256_setzero_si256()
-    #define NumRegistersSIMD 16
+    // The per-microarchitecture build targets (znver4, znver5, sapphirerapids)
+    // pin the accumulation tiling to the full 32-entry zmm register file;
+    // the generic avx512/vnni512 profiles keep the conservative 16.
+    #if defined(USE_FULL_SIMD_REGISTER_FILE)
+        #define NumRegistersSIMD 32
+    #else
+        #define NumRegistersSIMD 16
+    #endif
     #define MaxChunkSize 64
 
 #elif USE_AVX2
@@ -87,6 +120,9 @@ using psqt_vec_t = __m256i;
     #define vec_slli_16(a, b) _mm256_slli_epi16(a, b)
     // Inverse permuted at load time
     #define vec_packus_16(a, b) _mm256_packus_epi16(a, b)
+    #define vec_load_w8(a) \
+        _mm256_slli_epi16( \
+          _mm256_cvtepi8_epi16(_mm_load_si128(reinterpret_cast<const __m128i*>(a))), 1)
     #define vec_load_psqt(a) _mm256_load_si256(a)
     #define vec_store_psqt(a, b) _mm256_store_si256(a, b)
     #define vec_add_psqt_32(a, b) _mm256_add_epi32(a, b)
@@ -109,6 +145,13 @@ using psqt_vec_t = __m128i;
     #define vec_min_16(a, b) _mm_min_epi16(a, b)
     #define vec_slli_16(a, b) _mm_slli_epi16(a, b)
     #define vec_packus_16(a, b) _mm_packus_epi16(a, b)
+    // Unpacking against zero puts each weight in the high byte (w * 256);
+    // an arithmetic shift right by 7 then yields the sign-correct w * 2
+    #define vec_load_w8(a) \
+        _mm_srai_epi16( \
+          _mm_unpacklo_epi8(_mm_setzero_si128(), \
+                            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(a))), \
+          7)
     #define vec_load_psqt(a) (*(a))
     #define vec_store_psqt(a, b) *(a) = (b)
     #define vec_add_psqt_32(a, b) _mm_add_epi32(a, b)
@@ -132,6 +175,7 @@ using psqt_vec_t = int32x4_t;
     #define vec_min_16(a, b) vminq_s16(a, b)
     #define vec_slli_16(a, b) vshlq_s16(a, vec_set_16(b))
     #define vec_packus_16(a, b) reinterpret_cast<vec_t>(vcombine_u8(vqmovun_s16(a), vqmovun_s16(b)))
+    #define vec_load_w8(a) vshll_n_s8(vld1_s8(reinterpret_cast<const std::int8_t*>(a)), 1)
     #define vec_load_psqt(a) (*(a))
     #define vec_store_psqt(a, b) *(a) = (b)
     #define vec_add_psqt_32(a, b) vaddq_s32(a, b)
@@ -146,6 +190,17 @@ using psqt_vec_t = int32x4_t;
 
 #endif
 
+#ifdef VECTOR
+    // The i-th register's worth of a weight column, a plain aligned load for
+    // int16 storage and a widening one for the int8 throughput build. One
+    // vec_t holds sizeof(vec_t) / 2 weights in either case.
+    #if defined(NNUE_FAST8)
+        #define vec_weight(column, i) vec_load_w8((column) + (i) * (IndexType(sizeof(vec_t)) / 2))
+    #else
+        #define vec_weight(column, i) vec_load(reinterpret_cast<const vec_t*>(column) + (i))
+    #endif
+#endif
+
 // Returns the inverse of a permutation
 template<std::size_t Len>
 constexpr std::array<std::size_t, Len>
@@ -294,21 +349,24 @@ class FeatureTransformer {
 
     void permute_weights() {
         permute<16>(biases, PackusEpi16Order);
-        permute<16>(weights, PackusEpi16Order);
+        // A 128-bit block of the widened int16 stream covers 8 stored weights
+        permute<8 * sizeof(StoredWeightType)>(weights, PackusEpi16Order);
     }
 
     void unpermute_weights() {
         permute<16>(biases, InversePackusEpi16Order);
-        permute<16>(weights, InversePackusEpi16Order);
+        permute<8 * sizeof(StoredWeightType)>(weights, InversePackusEpi16Order);
     }
 
     inline void scale_weights(bool read) {
+#if !defined(NNUE_FAST8)
         for (IndexType j = 0; j < InputDimensions; ++j)
         {
             WeightType* w = &weights[j * HalfDimensions];
             for (IndexType i = 0; i < HalfDimensions; ++i)
                 w[i] = read ? w[i] * 2 : w[i] / 2;
         }
+#endif
 
         for (IndexType i = 0; i < HalfDimensions; ++i)
             biases[i] = read ? biases[i] * 2 : biases[i] / 2;
@@ -318,7 +376,19 @@ class FeatureTransformer {
     bool read_parameters(std::istream& stream) {
 
         read_leb_128<BiasType>(stream, biases, HalfDimensions);
+#if defined(NNUE_FAST8)
+        // Decode into a transient int16 buffer, then quantize. The on-disk
+        // format is unchanged; the saturation only lives in memory.
+        {
+            auto w16 = std::make_unique<WeightType[]>(std::size_t(HalfDimensions)
+                                                      * InputDimensions);
+            read_leb_128<WeightType>(stream, w16.get(), HalfDimensions * InputDimensions);
+            for (std::size_t i = 0; i < std::size_t(HalfDimensions) * InputDimensions; ++i)
+                weights[i] = StoredWeightType(std::clamp<int>(w16[i], -127, 127));
+        }
+#else
         read_leb_128<WeightType>(stream, weights, HalfDimensions * InputDimensions);
+#endif
         read_leb_128<PSQTWeightType>(stream, psqtWeights, PSQTBuckets * InputDimensions);
 
         permute_weights();
@@ -333,7 +403,18 @@ class FeatureTransformer {
         scale_weights(false);
 
         write_leb_128<BiasType>(stream, biases, HalfDimensions);
+#if defined(NNUE_FAST8)
+        // Exports from a throughput build carry its quantized weights
+        {
+            auto w16 = std::make_unique<WeightType[]>(std::size_t(HalfDimensions)
+                                                      * InputDimensions);
+            for (std::size_t i = 0; i < std::size_t(HalfDimensions) * InputDimensions; ++i)
+                w16[i] = WeightType(weights[i]);
+            write_leb_128<WeightType>(stream, w16.get(), HalfDimensions * InputDimensions);
+        }
+#else
         write_leb_128<WeightType>(stream, weights, HalfDimensions * InputDimensions);
+#endif
         write_leb_128<PSQTWeightType>(stream, psqtWeights, PSQTBuckets * InputDimensions);
 
         permute_weights();
@@ -468,6 +549,22 @@ class FeatureTransformer {
         return psqt;
     }  // end of function transform()
 
+    // Only the PSQT half of the output: the accumulators are brought up to
+    // date as usual, but the perspective transform of the feature halves is
+    // skipped entirely, see Network::evaluate_psqt()
+    std::int32_t transform_psqt(const Position&                           pos,
+                                AccumulatorCaches::Cache<HalfDimensions>* cache,
+                                int                                       bucket) const {
+        update_accumulator<WHITE>(pos, cache);
+        update_accumulator<BLACK>(pos, cache);
+
+        const Color perspectives[2]  = {pos.side_to_move(), ~pos.side_to_move()};
+        const auto& psqtAccumulation = (pos.state()->*accPtr).psqtAccumulation;
+        return (psqtAccumulation[perspectives[0]][bucket]
+                - psqtAccumulation[perspectives[1]][bucket])
+             / 2;
+    }
+
     void hint_common_access(const Position&                           pos,
                             AccumulatorCaches::Cache<HalfDimensions>* cache) const {
         update_accumulator<WHITE>(pos, cache);
@@ -493,6 +590,199 @@ class FeatureTransformer {
         return st;
     }
 
+#ifdef VECTOR
+    // Runtime-to-compile-time dispatch on the (added, removed) counts of one
+    // move. Incremental updates only produce the shapes 1+1 (quiet moves and
+    // promotions), 1+2 (captures, en passant) and 2+2 (castling), so each
+    // dirty-piece shape gets its own fully unrolled delta pass below, the way
+    // the affine layers specialize on their dimensions.
+    template<typename F>
+    static void dispatch_counts(std::size_t added, std::size_t removed, F&& f) {
+        using One = std::integral_constant<std::size_t, 1>;
+        using Two = std::integral_constant<std::size_t, 2>;
+
+        if (removed == 1)
+            f(One{}, One{});
+        else if (added == 1)
+            f(One{}, Two{});
+        else
+            f(Two{}, Two{});
+    }
+
+    // Applies all feature deltas of one move to a whole accumulator row in a
+    // single pass: out = in + sum(added columns) - sum(removed columns)
+    template<Color Perspective, std::size_t NAdded, std::size_t NRemoved>
+    void apply_deltas(const StateInfo*             computed,
+                      StateInfo*                   next,
+                      const FeatureSet::IndexList& added,
+                      const FeatureSet::IndexList& removed) const {
+
+        const StoredWeightType* columnA[NAdded];
+        const StoredWeightType* columnR[NRemoved];
+        const psqt_vec_t*       columnPsqtA[NAdded];
+        const psqt_vec_t*       columnPsqtR[NRemoved];
+
+        for (std::size_t k = 0; k < NAdded; ++k)
+        {
+            columnA[k] = &weights[HalfDimensions * added[k]];
+            columnPsqtA[k] =
+              reinterpret_cast<const psqt_vec_t*>(&psqtWeights[PSQTBuckets * added[k]]);
+        }
+        for (std::size_t k = 0; k < NRemoved; ++k)
+        {
+            columnR[k] = &weights[HalfDimensions * removed[k]];
+            columnPsqtR[k] =
+              reinterpret_cast<const psqt_vec_t*>(&psqtWeights[PSQTBuckets * removed[k]]);
+        }
+
+        auto* accIn =
+          reinterpret_cast<const vec_t*>(&(computed->*accPtr).accumulation[Perspective][0]);
+        auto* accOut = reinterpret_cast<vec_t*>(&(next->*accPtr).accumulation[Perspective][0]);
+
+        for (IndexType i = 0; i < HalfDimensions * sizeof(WeightType) / sizeof(vec_t); ++i)
+        {
+            vec_t adds = vec_weight(columnA[0], i);
+            for (std::size_t k = 1; k < NAdded; ++k)
+                adds = vec_add_16(adds, vec_weight(columnA[k], i));
+
+            vec_t subs = vec_weight(columnR[0], i);
+            for (std::size_t k = 1; k < NRemoved; ++k)
+                subs = vec_add_16(subs, vec_weight(columnR[k], i));
+
+            accOut[i] = vec_add_16(accIn[i], vec_sub_16(adds, subs));
+        }
+
+        auto* accPsqtIn = reinterpret_cast<const psqt_vec_t*>(
+          &(computed->*accPtr).psqtAccumulation[Perspective][0]);
+        auto* accPsqtOut =
+          reinterpret_cast<psqt_vec_t*>(&(next->*accPtr).psqtAccumulation[Perspective][0]);
+
+        for (std::size_t i = 0; i < PSQTBuckets * sizeof(PSQTWeightType) / sizeof(psqt_vec_t); ++i)
+        {
+            psqt_vec_t adds = columnPsqtA[0][i];
+            for (std::size_t k = 1; k < NAdded; ++k)
+                adds = vec_add_psqt_32(adds, columnPsqtA[k][i]);
+
+            psqt_vec_t subs = columnPsqtR[0][i];
+            for (std::size_t k = 1; k < NRemoved; ++k)
+                subs = vec_add_psqt_32(subs, columnPsqtR[k][i]);
+
+            accPsqtOut[i] = vec_add_psqt_32(accPsqtIn[i], vec_sub_psqt_32(adds, subs));
+        }
+    }
+
+    // Fused variant updating two successive plies in one pass: the middle
+    // accumulator is produced in registers and stored, but never re-loaded,
+    // so the input row is walked once instead of twice
+    template<Color     Perspective,
+             std::size_t NAdded1,
+             std::size_t NRemoved1,
+             std::size_t NAdded2,
+             std::size_t NRemoved2>
+    void apply_deltas2(const StateInfo*             computed,
+                       StateInfo*                   mid,
+                       StateInfo*                   next,
+                       const FeatureSet::IndexList& added1,
+                       const FeatureSet::IndexList& removed1,
+                       const FeatureSet::IndexList& added2,
+                       const FeatureSet::IndexList& removed2) const {
+
+        const StoredWeightType* columnA1[NAdded1];
+        const StoredWeightType* columnR1[NRemoved1];
+        const StoredWeightType* columnA2[NAdded2];
+        const StoredWeightType* columnR2[NRemoved2];
+        const psqt_vec_t*       columnPsqtA1[NAdded1];
+        const psqt_vec_t*       columnPsqtR1[NRemoved1];
+        const psqt_vec_t*       columnPsqtA2[NAdded2];
+        const psqt_vec_t*       columnPsqtR2[NRemoved2];
+
+        for (std::size_t k = 0; k < NAdded1; ++k)
+        {
+            columnA1[k] = &weights[HalfDimensions * added1[k]];
+            columnPsqtA1[k] =
+              reinterpret_cast<const psqt_vec_t*>(&psqtWeights[PSQTBuckets * added1[k]]);
+        }
+        for (std::size_t k = 0; k < NRemoved1; ++k)
+        {
+            columnR1[k] = &weights[HalfDimensions * removed1[k]];
+            columnPsqtR1[k] =
+              reinterpret_cast<const psqt_vec_t*>(&psqtWeights[PSQTBuckets * removed1[k]]);
+        }
+        for (std::size_t k = 0; k < NAdded2; ++k)
+        {
+            columnA2[k] = &weights[HalfDimensions * added2[k]];
+            columnPsqtA2[k] =
+              reinterpret_cast<const psqt_vec_t*>(&psqtWeights[PSQTBuckets * added2[k]]);
+        }
+        for (std::size_t k = 0; k < NRemoved2; ++k)
+        {
+            columnR2[k] = &weights[HalfDimensions * removed2[k]];
+            columnPsqtR2[k] =
+              reinterpret_cast<const psqt_vec_t*>(&psqtWeights[PSQTBuckets * removed2[k]]);
+        }
+
+        auto* accIn =
+          reinterpret_cast<const vec_t*>(&(computed->*accPtr).accumulation[Perspective][0]);
+        auto* accMid = reinterpret_cast<vec_t*>(&(mid->*accPtr).accumulation[Perspective][0]);
+        auto* accOut = reinterpret_cast<vec_t*>(&(next->*accPtr).accumulation[Perspective][0]);
+
+        for (IndexType i = 0; i < HalfDimensions * sizeof(WeightType) / sizeof(vec_t); ++i)
+        {
+            vec_t adds = vec_weight(columnA1[0], i);
+            for (std::size_t k = 1; k < NAdded1; ++k)
+                adds = vec_add_16(adds, vec_weight(columnA1[k], i));
+
+            vec_t subs = vec_weight(columnR1[0], i);
+            for (std::size_t k = 1; k < NRemoved1; ++k)
+                subs = vec_add_16(subs, vec_weight(columnR1[k], i));
+
+            const vec_t v = vec_add_16(accIn[i], vec_sub_16(adds, subs));
+            accMid[i]     = v;
+
+            adds = vec_weight(columnA2[0], i);
+            for (std::size_t k = 1; k < NAdded2; ++k)
+                adds = vec_add_16(adds, vec_weight(columnA2[k], i));
+
+            subs = vec_weight(columnR2[0], i);
+            for (std::size_t k = 1; k < NRemoved2; ++k)
+                subs = vec_add_16(subs, vec_weight(columnR2[k], i));
+
+            accOut[i] = vec_add_16(v, vec_sub_16(adds, subs));
+        }
+
+        auto* accPsqtIn = reinterpret_cast<const psqt_vec_t*>(
+          &(computed->*accPtr).psqtAccumulation[Perspective][0]);
+        auto* accPsqtMid =
+          reinterpret_cast<psqt_vec_t*>(&(mid->*accPtr).psqtAccumulation[Perspective][0]);
+        auto* accPsqtOut =
+          reinterpret_cast<psqt_vec_t*>(&(next->*accPtr).psqtAccumulation[Perspective][0]);
+
+        for (std::size_t i = 0; i < PSQTBuckets * sizeof(PSQTWeightType) / sizeof(psqt_vec_t); ++i)
+        {
+            psqt_vec_t adds = columnPsqtA1[0][i];
+            for (std::size_t k = 1; k < NAdded1; ++k)
+                adds = vec_add_psqt_32(adds, columnPsqtA1[k][i]);
+
+            psqt_vec_t subs = columnPsqtR1[0][i];
+            for (std::size_t k = 1; k < NRemoved1; ++k)
+                subs = vec_add_psqt_32(subs, columnPsqtR1[k][i]);
+
+            const psqt_vec_t v = vec_add_psqt_32(accPsqtIn[i], vec_sub_psqt_32(adds, subs));
+            accPsqtMid[i]      = v;
+
+            adds = columnPsqtA2[0][i];
+            for (std::size_t k = 1; k < NAdded2; ++k)
+                adds = vec_add_psqt_32(adds, columnPsqtA2[k][i]);
+
+            subs = columnPsqtR2[0][i];
+            for (std::size_t k = 1; k < NRemoved2; ++k)
+                subs = vec_add_psqt_32(subs, columnPsqtR2[k][i]);
+
+            accPsqtOut[i] = vec_add_psqt_32(v, vec_sub_psqt_32(adds, subs));
+        }
+    }
+#endif
+
     // Given a computed accumulator, computes the accumulator of the next position.
     template<Color Perspective>
     void update_accumulator_incremental(const Position& pos, StateInfo* computed) const {
@@ -530,87 +820,40 @@ class FeatureTransformer {
             assert(added.size() <= removed.size());
 
 #ifdef VECTOR
-            auto* accIn =
-              reinterpret_cast<const vec_t*>(&(computed->*accPtr).accumulation[Perspective][0]);
-            auto* accOut = reinterpret_cast<vec_t*>(&(next->*accPtr).accumulation[Perspective][0]);
-
-            const IndexType offsetA0 = HalfDimensions * added[0];
-            auto*           columnA0 = reinterpret_cast<const vec_t*>(&weights[offsetA0]);
-            const IndexType offsetR0 = HalfDimensions * removed[0];
-            auto*           columnR0 = reinterpret_cast<const vec_t*>(&weights[offsetR0]);
-
-            if (removed.size() == 1)
-            {
-                for (IndexType i = 0; i < HalfDimensions * sizeof(WeightType) / sizeof(vec_t); ++i)
-                    accOut[i] = vec_add_16(vec_sub_16(accIn[i], columnR0[i]), columnA0[i]);
-            }
-            else if (added.size() == 1)
+            // When two plies are pending, fuse their updates into a single
+            // pass over the accumulator, see apply_deltas2()
+            StateInfo* next2 = next != pos.state() ? next->next : nullptr;
+            if (next2)
             {
-                const IndexType offsetR1 = HalfDimensions * removed[1];
-                auto*           columnR1 = reinterpret_cast<const vec_t*>(&weights[offsetR1]);
+                FeatureSet::IndexList removed2, added2;
+                FeatureSet::append_changed_indices<Perspective>(ksq, next2->dirtyPiece, removed2,
+                                                                added2);
 
-                for (IndexType i = 0; i < HalfDimensions * sizeof(WeightType) / sizeof(vec_t); ++i)
-                    accOut[i] = vec_sub_16(vec_add_16(accIn[i], columnA0[i]),
-                                           vec_add_16(columnR0[i], columnR1[i]));
-            }
-            else
-            {
-                const IndexType offsetA1 = HalfDimensions * added[1];
-                auto*           columnA1 = reinterpret_cast<const vec_t*>(&weights[offsetA1]);
-                const IndexType offsetR1 = HalfDimensions * removed[1];
-                auto*           columnR1 = reinterpret_cast<const vec_t*>(&weights[offsetR1]);
-
-                for (IndexType i = 0; i < HalfDimensions * sizeof(WeightType) / sizeof(vec_t); ++i)
-                    accOut[i] =
-                      vec_add_16(accIn[i], vec_sub_16(vec_add_16(columnA0[i], columnA1[i]),
-                                                      vec_add_16(columnR0[i], columnR1[i])));
+                if (added2.size() != 0 || removed2.size() != 0)
+                {
+                    assert(!(next2->*accPtr).computed[Perspective]);
+
+                    dispatch_counts(added.size(), removed.size(), [&](auto na1, auto nr1) {
+                        dispatch_counts(added2.size(), removed2.size(), [&](auto na2, auto nr2) {
+                            apply_deltas2<Perspective, decltype(na1)::value, decltype(nr1)::value,
+                                          decltype(na2)::value, decltype(nr2)::value>(
+                              computed, next, next2, added, removed, added2, removed2);
+                        });
+                    });
+
+                    (next->*accPtr).computed[Perspective]  = true;
+                    (next2->*accPtr).computed[Perspective] = true;
+
+                    if (next2 != pos.state())
+                        update_accumulator_incremental<Perspective>(pos, next2);
+                    return;
+                }
             }
 
-            auto* accPsqtIn = reinterpret_cast<const psqt_vec_t*>(
-              &(computed->*accPtr).psqtAccumulation[Perspective][0]);
-            auto* accPsqtOut =
-              reinterpret_cast<psqt_vec_t*>(&(next->*accPtr).psqtAccumulation[Perspective][0]);
-
-            const IndexType offsetPsqtA0 = PSQTBuckets * added[0];
-            auto* columnPsqtA0 = reinterpret_cast<const psqt_vec_t*>(&psqtWeights[offsetPsqtA0]);
-            const IndexType offsetPsqtR0 = PSQTBuckets * removed[0];
-            auto* columnPsqtR0 = reinterpret_cast<const psqt_vec_t*>(&psqtWeights[offsetPsqtR0]);
-
-            if (removed.size() == 1)
-            {
-                for (std::size_t i = 0;
-                     i < PSQTBuckets * sizeof(PSQTWeightType) / sizeof(psqt_vec_t); ++i)
-                    accPsqtOut[i] = vec_add_psqt_32(vec_sub_psqt_32(accPsqtIn[i], columnPsqtR0[i]),
-                                                    columnPsqtA0[i]);
-            }
-            else if (added.size() == 1)
-            {
-                const IndexType offsetPsqtR1 = PSQTBuckets * removed[1];
-                auto*           columnPsqtR1 =
-                  reinterpret_cast<const psqt_vec_t*>(&psqtWeights[offsetPsqtR1]);
-
-                for (std::size_t i = 0;
-                     i < PSQTBuckets * sizeof(PSQTWeightType) / sizeof(psqt_vec_t); ++i)
-                    accPsqtOut[i] =
-                      vec_sub_psqt_32(vec_add_psqt_32(accPsqtIn[i], columnPsqtA0[i]),
-                                      vec_add_psqt_32(columnPsqtR0[i], columnPsqtR1[i]));
-            }
-            else
-            {
-                const IndexType offsetPsqtA1 = PSQTBuckets * added[1];
-                auto*           columnPsqtA1 =
-                  reinterpret_cast<const psqt_vec_t*>(&psqtWeights[offsetPsqtA1]);
-                const IndexType offsetPsqtR1 = PSQTBuckets * removed[1];
-                auto*           columnPsqtR1 =
-                  reinterpret_cast<const psqt_vec_t*>(&psqtWeights[offsetPsqtR1]);
-
-                for (std::size_t i = 0;
-                     i < PSQTBuckets * sizeof(PSQTWeightType) / sizeof(psqt_vec_t); ++i)
-                    accPsqtOut[i] = vec_add_psqt_32(
-                      accPsqtIn[i],
-                      vec_sub_psqt_32(vec_add_psqt_32(columnPsqtA0[i], columnPsqtA1[i]),
-                                      vec_add_psqt_32(columnPsqtR0[i], columnPsqtR1[i])));
-            }
+            dispatch_counts(added.size(), removed.size(), [&](auto na, auto nr) {
+                apply_deltas<Perspective, decltype(na)::value, decltype(nr)::value>(computed, next,
+                                                                                    added, removed);
+            });
 #else
             std::memcpy((next->*accPtr).accumulation[Perspective],
                         (computed->*accPtr).accumulation[Perspective],
@@ -624,7 +867,8 @@ class FeatureTransformer {
             {
                 const IndexType offset = HalfDimensions * index;
                 for (IndexType i = 0; i < HalfDimensions; ++i)
-                    (next->*accPtr).accumulation[Perspective][i] -= weights[offset + i];
+                    (next->*accPtr).accumulation[Perspective][i] -=
+                      StoredWeightScale * weights[offset + i];
 
                 for (std::size_t i = 0; i < PSQTBuckets; ++i)
                     (next->*accPtr).psqtAccumulation[Perspective][i] -=
@@ -636,7 +880,8 @@ class FeatureTransformer {
             {
                 const IndexType offset = HalfDimensions * index;
                 for (IndexType i = 0; i < HalfDimensions; ++i)
-                    (next->*accPtr).accumulation[Perspective][i] += weights[offset + i];
+                    (next->*accPtr).accumulation[Perspective][i] +=
+                      StoredWeightScale * weights[offset + i];
 
                 for (std::size_t i = 0; i < PSQTBuckets; ++i)
                     (next->*accPtr).psqtAccumulation[Perspective][i] +=
@@ -657,8 +902,16 @@ class FeatureTransformer {
                                           AccumulatorCaches::Cache<HalfDimensions>* cache) const {
         assert(cache != nullptr);
 
-        Square                ksq   = pos.square<KING>(Perspective);
-        auto&                 entry = (*cache)[ksq][Perspective];
+        Square ksq = pos.square<KING>(Perspective);
+
+        // Prefer the node-shared entry when it is free: siblings searching
+        // overlapping trees keep it closer to the current position than a
+        // private entry, so fewer feature columns need to be applied. When
+        // another thread holds it, fall back to the private entry rather
+        // than wait.
+        const bool useShared = cache->try_lock_shared(ksq, Perspective);
+        auto&      entry     = useShared ? (*cache->shared)[ksq][Perspective]  //
+                                         : (*cache)[ksq][Perspective];
         FeatureSet::IndexList removed, added;
 
         for (Color c : {WHITE, BLACK})
@@ -705,31 +958,32 @@ class FeatureTransformer {
             {
                 IndexType       indexR  = removed[i];
                 const IndexType offsetR = HalfDimensions * indexR + j * Tiling::TileHeight;
-                auto*           columnR = reinterpret_cast<const vec_t*>(&weights[offsetR]);
+                auto*           columnR = &weights[offsetR];
                 IndexType       indexA  = added[i];
                 const IndexType offsetA = HalfDimensions * indexA + j * Tiling::TileHeight;
-                auto*           columnA = reinterpret_cast<const vec_t*>(&weights[offsetA]);
+                auto*           columnA = &weights[offsetA];
 
                 for (IndexType k = 0; k < Tiling::NumRegs; ++k)
-                    acc[k] = vec_add_16(acc[k], vec_sub_16(columnA[k], columnR[k]));
+                    acc[k] =
+                      vec_add_16(acc[k], vec_sub_16(vec_weight(columnA, k), vec_weight(columnR, k)));
             }
             for (; i < removed.size(); ++i)
             {
                 IndexType       index  = removed[i];
                 const IndexType offset = HalfDimensions * index + j * Tiling::TileHeight;
-                auto*           column = reinterpret_cast<const vec_t*>(&weights[offset]);
+                auto*           column = &weights[offset];
 
                 for (IndexType k = 0; k < Tiling::NumRegs; ++k)
-                    acc[k] = vec_sub_16(acc[k], column[k]);
+                    acc[k] = vec_sub_16(acc[k], vec_weight(column, k));
             }
             for (; i < added.size(); ++i)
             {
                 IndexType       index  = added[i];
                 const IndexType offset = HalfDimensions * index + j * Tiling::TileHeight;
-                auto*           column = reinterpret_cast<const vec_t*>(&weights[offset]);
+                auto*           column = &weights[offset];
 
                 for (IndexType k = 0; k < Tiling::NumRegs; ++k)
-                    acc[k] = vec_add_16(acc[k], column[k]);
+                    acc[k] = vec_add_16(acc[k], vec_weight(column, k));
             }
 
             for (IndexType k = 0; k < Tiling::NumRegs; k++)
@@ -779,7 +1033,7 @@ class FeatureTransformer {
         {
             const IndexType offset = HalfDimensions * index;
             for (IndexType j = 0; j < HalfDimensions; ++j)
-                entry.accumulation[j] -= weights[offset + j];
+                entry.accumulation[j] -= StoredWeightScale * weights[offset + j];
 
             for (std::size_t k = 0; k < PSQTBuckets; ++k)
                 entry.psqtAccumulation[k] -= psqtWeights[index * PSQTBuckets + k];
@@ -788,7 +1042,7 @@ class FeatureTransformer {
         {
             const IndexType offset = HalfDimensions * index;
             for (IndexType j = 0; j < HalfDimensions; ++j)
-                entry.accumulation[j] += weights[offset + j];
+                entry.accumulation[j] += StoredWeightScale * weights[offset + j];
 
             for (std::size_t k = 0; k < PSQTBuckets; ++k)
                 entry.psqtAccumulation[k] += psqtWeights[index * PSQTBuckets + k];
@@ -809,6 +1063,9 @@ class FeatureTransformer {
 
         for (PieceType pt = PAWN; pt <= KING; ++pt)
             entry.byTypeBB[pt] = pos.pieces(pt);
+
+        if (useShared)
+            cache->unlock_shared(ksq, Perspective);
     }
 
 
@@ -820,18 +1077,24 @@ class FeatureTransformer {
         StateInfo* oldest = try_find_computed_accumulator<Perspective>(pos);
 
         if ((oldest->*accPtr).computed[Perspective] && oldest != pos.state())
+        {
             // Start from the oldest computed accumulator, update all the
             // accumulators up to the current position.
+            stats_count(STATS_ACC_UPDATE);
             update_accumulator_incremental<Perspective>(pos, oldest);
+        }
         else
+        {
+            stats_count(STATS_ACC_REFRESH);
             update_accumulator_refresh_cache<Perspective>(pos, cache);
+        }
     }
 
     template<IndexType Size>
     friend struct AccumulatorCaches::Cache;
 
     alignas(CacheLineSize) BiasType biases[HalfDimensions];
-    alignas(CacheLineSize) WeightType weights[HalfDimensions * InputDimensions];
+    alignas(CacheLineSize) StoredWeightType weights[HalfDimensions * InputDimensions];
     alignas(CacheLineSize) PSQTWeightType psqtWeights[InputDimensions * PSQTBuckets];
 };
 
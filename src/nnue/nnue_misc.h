@@ -56,7 +56,8 @@ struct AccumulatorCaches;
 std::string trace(Position& pos, const Networks& networks, AccumulatorCaches& caches);
 void        hint_common_parent_position(const Position&    pos,
                                         const Networks&    networks,
-                                        AccumulatorCaches& caches);
+                                        AccumulatorCaches& caches,
+                                        bool               smallNetOnly = false);
 
 }  // namespace Stockfish::Eval::NNUE
 }  // namespace Stockfish
@@ -0,0 +1,97 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2025 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NODETRACE_H_INCLUDED
+#define NODETRACE_H_INCLUDED
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "types.h"
+
+namespace Stockfish {
+
+// One visited node of the search tree. Together with the key of the parent
+// (reached via the stored move) this is enough to reconstruct the tree
+// offline. Written to disk verbatim in host byte order by 'tracedump'.
+struct NodeTraceRecord {
+    Key           key;
+    std::int16_t  alpha;
+    std::int16_t  beta;
+    std::int16_t  staticEval;
+    std::uint16_t move;  // Raw encoding of the move that led to the node
+    std::uint8_t  depth;
+    std::uint8_t  ttHit;
+};
+
+// Per-thread ring buffer of visited nodes, enabled with the 'Trace Nodes'
+// option (megabytes per thread) and dumped with the 'tracedump' command.
+// The fixed capacity keeps the tracing overhead and memory bounded no matter
+// how long the search runs, at the price of keeping only the newest records;
+// when tracing is off, the only per-node cost is one well-predicted branch
+// on enabled().
+class NodeTraceBuffer {
+   public:
+    void resize(size_t mbSize) {
+
+        size_t entries = 0;
+        if (mbSize)
+        {
+            entries = 1;
+            while (entries * 2 * sizeof(NodeTraceRecord) <= mbSize * 1024 * 1024)
+                entries *= 2;
+        }
+
+        ring.resize(entries);
+        ring.shrink_to_fit();
+        mask = entries ? entries - 1 : 0;
+        head = 0;
+    }
+
+    bool enabled() const { return !ring.empty(); }
+
+    void push(Key key, Move move, Depth depth, Value alpha, Value beta, Value ev, bool ttHit) {
+
+        NodeTraceRecord& r = ring[head++ & mask];
+        r.key              = key;
+        r.alpha            = std::int16_t(alpha);
+        r.beta             = std::int16_t(beta);
+        r.staticEval       = std::int16_t(ev);
+        r.move             = move.raw();
+        r.depth            = std::uint8_t(std::clamp(int(depth), 0, 255));
+        r.ttHit            = ttHit;
+    }
+
+    // Number of valid records, and oldest-first access to them
+    size_t count() const { return size_t(std::min<uint64_t>(head, ring.size())); }
+
+    const NodeTraceRecord& at(size_t i) const {
+        uint64_t first = head > ring.size() ? head : 0;
+        return ring[(first + i) & mask];
+    }
+
+   private:
+    std::vector<NodeTraceRecord> ring;
+    size_t                       mask = 0;
+    uint64_t                     head = 0;
+};
+
+}  // namespace Stockfish
+
+#endif  // #ifndef NODETRACE_H_INCLUDED
@@ -467,6 +467,7 @@ class NumaConfig {
         customAffinity(false) {
         const auto numCpus = SYSTEM_THREADS_NB;
         add_cpu_range_to_node(NumaIndex{0}, CpuIndex{0}, numCpus - 1);
+        build_cache_domains({});
     }
 
     // This function queries the system for the mapping of processors to NUMA nodes.
@@ -635,6 +636,30 @@ class NumaConfig {
         // We have to ensure no empty NUMA nodes persist.
         cfg.remove_empty_numa_nodes();
 
+        // Discover last-level-cache sharing domains (CCX granularity on AMD,
+        // where one NUMA node contains many separate L3s). On Linux the sysfs
+        // cache topology gives us, for each cpu, the set of cpus sharing its
+        // L3; the lowest cpu of that set serves as the domain's identity.
+#if defined(__linux__) && !defined(__ANDROID__)
+        std::map<CpuIndex, size_t> l3GroupOfCpu;
+        for (const auto& [c, n] : cfg.nodeByCpu)
+        {
+            std::string path = std::string("/sys/devices/system/cpu/cpu") + std::to_string(c)
+                             + "/cache/index3/shared_cpu_list";
+            auto cpuIdsStr = read_file_to_string(path);
+            if (!cpuIdsStr.has_value())
+                continue;
+
+            remove_whitespace(*cpuIdsStr);
+            auto shared = indices_from_shortened_string(*cpuIdsStr);
+            if (!shared.empty())
+                l3GroupOfCpu[c] = shared.front();
+        }
+        cfg.build_cache_domains(l3GroupOfCpu);
+#else
+        cfg.build_cache_domains({});
+#endif
+
         // If the user explicitly opts out from respecting the current process affinity
         // then it may be inconsistent with the current affinity (obviously), so we
         // consider it custom.
@@ -668,6 +693,7 @@ class NumaConfig {
         }
 
         cfg.customAffinity = true;
+        cfg.build_cache_domains({});
 
         return cfg;
     }
@@ -688,6 +714,18 @@ class NumaConfig {
 
     CpuIndex num_cpus() const { return nodeByCpu.size(); }
 
+    size_t num_cache_domains() const { return cacheDomains.size(); }
+
+    NumaIndex cache_domain_numa_node(size_t d) const {
+        assert(d < cacheDomainToNode.size());
+        return cacheDomainToNode[d];
+    }
+
+    CpuIndex num_cpus_in_cache_domain(size_t d) const {
+        assert(d < cacheDomains.size());
+        return cacheDomains[d].size();
+    }
+
     bool requires_memory_replication() const { return customAffinity || nodes.size() > 1; }
 
     std::string to_string() const {
@@ -813,10 +851,61 @@ class NumaConfig {
         return ns;
     }
 
+    // Like distribute_threads_among_numa_nodes(), but at last-level-cache
+    // granularity: each thread keeps the NUMA node the node-level distribution
+    // gives it and additionally gets the least-filled cache domain within that
+    // node, so per-thread working sets spread over all L3s and structures
+    // shared between co-located threads stay within one cache domain.
+    std::vector<size_t> distribute_threads_among_cache_domains(CpuIndex numThreads) const {
+        const std::vector<NumaIndex> ns = distribute_threads_among_numa_nodes(numThreads);
+
+        std::vector<size_t> ds;
+        std::vector<size_t> occupation(cacheDomains.size(), 0);
+        for (NumaIndex n : ns)
+        {
+            size_t bestDomain = 0;
+            float  bestFill   = std::numeric_limits<float>::max();
+            for (size_t d = 0; d < cacheDomains.size(); ++d)
+            {
+                if (cacheDomainToNode[d] != n)
+                    continue;
+
+                float fill = static_cast<float>(occupation[d] + 1)
+                           / static_cast<float>(cacheDomains[d].size());
+                if (fill < bestFill)
+                {
+                    bestDomain = d;
+                    bestFill   = fill;
+                }
+            }
+            ds.emplace_back(bestDomain);
+            occupation[bestDomain] += 1;
+        }
+
+        return ds;
+    }
+
     NumaReplicatedAccessToken bind_current_thread_to_numa_node(NumaIndex n) const {
         if (n >= nodes.size() || nodes[n].size() == 0)
             std::exit(EXIT_FAILURE);
 
+        return bind_current_thread_to_cpus(nodes[n], n);
+    }
+
+    // Binds to the cpus of one last-level-cache domain. The access token still
+    // carries the domain's NUMA node, since that is what replicated memory is
+    // keyed on; the tighter affinity only affects scheduling and first-touch.
+    NumaReplicatedAccessToken bind_current_thread_to_cache_domain(size_t d) const {
+        if (d >= cacheDomains.size() || cacheDomains[d].size() == 0)
+            std::exit(EXIT_FAILURE);
+
+        return bind_current_thread_to_cpus(cacheDomains[d], cacheDomainToNode[d]);
+    }
+
+   private:
+    NumaReplicatedAccessToken bind_current_thread_to_cpus(const std::set<CpuIndex>& cpus,
+                                                          NumaIndex                 n) const {
+
 #if defined(__linux__) && !defined(__ANDROID__)
 
         cpu_set_t* mask = CPU_ALLOC(highestCpuIndex + 1);
@@ -827,7 +916,7 @@ class NumaConfig {
 
         CPU_ZERO_S(masksize, mask);
 
-        for (CpuIndex c : nodes[n])
+        for (CpuIndex c : cpus)
             CPU_SET_S(c, masksize, mask);
 
         const int status = sched_setaffinity(0, masksize, mask);
@@ -863,7 +952,7 @@ class NumaConfig {
             for (WORD i = 0; i < numProcGroups; ++i)
                 groupAffinities[i].Group = i;
 
-            for (CpuIndex c : nodes[n])
+            for (CpuIndex c : cpus)
             {
                 const size_t procGroupIndex     = c / WIN_PROCESSOR_GROUP_SIZE;
                 const size_t idxWithinProcGroup = c % WIN_PROCESSOR_GROUP_SIZE;
@@ -904,9 +993,9 @@ class NumaConfig {
             GROUP_AFFINITY affinity;
             std::memset(&affinity, 0, sizeof(GROUP_AFFINITY));
             // We use an ordered set to be sure to get the smallest cpu number here.
-            const size_t forcedProcGroupIndex = *(nodes[n].begin()) / WIN_PROCESSOR_GROUP_SIZE;
+            const size_t forcedProcGroupIndex = *(cpus.begin()) / WIN_PROCESSOR_GROUP_SIZE;
             affinity.Group                    = static_cast<WORD>(forcedProcGroupIndex);
-            for (CpuIndex c : nodes[n])
+            for (CpuIndex c : cpus)
             {
                 const size_t procGroupIndex     = c / WIN_PROCESSOR_GROUP_SIZE;
                 const size_t idxWithinProcGroup = c % WIN_PROCESSOR_GROUP_SIZE;
@@ -935,6 +1024,7 @@ class NumaConfig {
         return NumaReplicatedAccessToken(n);
     }
 
+   public:
     template<typename FuncT>
     void execute_on_numa_node(NumaIndex n, FuncT&& f) const {
         std::thread th([this, &f, n]() {
@@ -950,6 +1040,12 @@ class NumaConfig {
     std::map<CpuIndex, NumaIndex>   nodeByCpu;
     CpuIndex                        highestCpuIndex;
 
+    // Last-level-cache sharing domains, each a subset of the cpus of exactly
+    // one NUMA node, ordered by node. With no topology information every node
+    // forms a single domain, making the domain model a strict refinement.
+    std::vector<std::set<CpuIndex>> cacheDomains;
+    std::vector<NumaIndex>          cacheDomainToNode;
+
     bool customAffinity;
 
     static NumaConfig empty() { return NumaConfig(EmptyNodeTag{}); }
@@ -968,6 +1064,34 @@ class NumaConfig {
         nodes = std::move(newNodes);
     }
 
+    // Partitions every NUMA node into last-level-cache sharing domains using
+    // the given cpu -> L3 group mapping. Cpus with no known group fall into a
+    // per-node catch-all, so with an empty mapping each node is one domain.
+    // Must run after the node set is final, since domains reference nodes by
+    // index.
+    void build_cache_domains(const std::map<CpuIndex, size_t>& l3GroupOfCpu) {
+        cacheDomains.clear();
+        cacheDomainToNode.clear();
+
+        for (NumaIndex n = 0; n < nodes.size(); ++n)
+        {
+            std::map<size_t, std::set<CpuIndex>> groups;
+            for (CpuIndex c : nodes[n])
+            {
+                auto         it = l3GroupOfCpu.find(c);
+                const size_t group =
+                  it != l3GroupOfCpu.end() ? it->second : std::numeric_limits<size_t>::max();
+                groups[group].insert(c);
+            }
+
+            for (auto& [group, cpus] : groups)
+            {
+                cacheDomains.emplace_back(std::move(cpus));
+                cacheDomainToNode.emplace_back(n);
+            }
+        }
+    }
+
     // Returns true if successful
     // Returns false if failed, i.e. when the cpu is already present
     //                          strong guarantee, the structure remains unmodified
@@ -1171,12 +1295,16 @@ class LazyNumaReplicated: public NumaReplicatedBase {
 
     LazyNumaReplicated(const LazyNumaReplicated&) = delete;
     LazyNumaReplicated(LazyNumaReplicated&& other) noexcept :
-        NumaReplicatedBase(std::move(other)),
-        instances(std::exchange(other.instances, {})) {}
+        NumaReplicatedBase(std::move(other)) {
+        other.wait_replication();
+        instances = std::exchange(other.instances, {});
+    }
 
     LazyNumaReplicated& operator=(const LazyNumaReplicated&) = delete;
     LazyNumaReplicated& operator=(LazyNumaReplicated&& other) noexcept {
         NumaReplicatedBase::operator=(*this, std::move(other));
+        wait_replication();
+        other.wait_replication();
         instances = std::exchange(other.instances, {});
 
         return *this;
@@ -1188,7 +1316,31 @@ class LazyNumaReplicated: public NumaReplicatedBase {
         return *this;
     }
 
-    ~LazyNumaReplicated() override = default;
+    ~LazyNumaReplicated() override { wait_replication(); }
+
+    // Fills the remaining nodes in the background instead of on first access,
+    // so the tens-of-MB cross-node copies overlap with the rest of startup.
+    // Each copy still runs on a thread bound to its target node, which both
+    // places and prefaults the pages node-locally. Concurrent first accesses
+    // remain safe: they serialize with the background copy on the same mutex
+    // ensure_present() has always used. Callers that must not fault during
+    // timed work (i.e. 'go') block in wait_replication() first.
+    void replicate_async() const {
+        wait_replication();
+
+        if (instances.size() < 2)
+            return;
+
+        asyncReplicator = std::thread([this]() {
+            for (NumaIndex idx = 1; idx < instances.size(); ++idx)
+                ensure_present(idx);
+        });
+    }
+
+    void wait_replication() const {
+        if (asyncReplicator.joinable())
+            asyncReplicator.join();
+    }
 
     const T& operator[](NumaReplicatedAccessToken token) const {
         assert(token.get_numa_index() < instances.size());
@@ -1202,12 +1354,16 @@ class LazyNumaReplicated: public NumaReplicatedBase {
 
     template<typename FuncT>
     void modify_and_replicate(FuncT&& f) {
+        wait_replication();
+
         auto source = std::move(instances[0]);
         std::forward<FuncT>(f)(*source);
         prepare_replicate_from(std::move(*source));
     }
 
     void on_numa_config_changed() override {
+        wait_replication();
+
         // Use the first one as the source. It doesn't matter which one we use,
         // because they all must be identical, but the first one is guaranteed to exist.
         auto source = std::move(instances[0]);
@@ -1217,6 +1373,7 @@ class LazyNumaReplicated: public NumaReplicatedBase {
    private:
     mutable std::vector<std::unique_ptr<T>> instances;
     mutable std::mutex                      mutex;
+    mutable std::thread                     asyncReplicator;
 
     void ensure_present(NumaIndex idx) const {
         assert(idx < instances.size());
@@ -1237,6 +1394,8 @@ class LazyNumaReplicated: public NumaReplicatedBase {
     }
 
     void prepare_replicate_from(T&& source) {
+        wait_replication();
+
         instances.clear();
 
         const NumaConfig& cfg = get_numa_config();
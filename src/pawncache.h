@@ -0,0 +1,104 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2025 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PAWNCACHE_H_INCLUDED
+#define PAWNCACHE_H_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "bitboard.h"
+#include "position.h"
+#include "types.h"
+
+namespace Stockfish {
+
+// Per-thread memoization of pawn-structure-derived bitboards, keyed by
+// Position::pawn_key(). Pawn keys repeat with very high locality within a
+// search, so a small direct-mapped table is enough: collisions simply
+// recompute and overwrite. The cached masks feed the move ordering
+// heuristics; probe/hit counters are reported by 'bench'.
+class PawnStructureCache {
+   public:
+    struct Entry {
+        Key      key = 0;
+        Bitboard passedPawns[COLOR_NB] = {};
+        Bitboard pawnAttacks[COLOR_NB] = {};
+        Bitboard openFiles = 0;
+    };
+
+    // Returns the entry for the position's pawn structure, computing and
+    // memoizing it on a miss. The reference stays valid only until the next
+    // probe with a different pawn key mapping to the same slot.
+    const Entry& probe(const Position& pos) {
+
+        Entry& e = table[pos.pawn_key() & (Size - 1)];
+        ++probes;
+
+        if (e.key == pos.pawn_key())
+        {
+            ++hits;
+            return e;
+        }
+
+        compute(e, pos);
+        return e;
+    }
+
+    void clear() { table.fill(Entry{}); }
+
+    // Cumulative since thread creation; consumers diff two snapshots
+    std::uint64_t probes = 0, hits = 0;
+
+   private:
+    static constexpr size_t Size = 8192;  // entries, power of two
+
+    static void compute(Entry& e, const Position& pos) {
+
+        const Bitboard wp = pos.pieces(WHITE, PAWN);
+        const Bitboard bp = pos.pieces(BLACK, PAWN);
+
+        auto fill_north = [](Bitboard b) {
+            b |= b << 8, b |= b << 16, b |= b << 32;
+            return b;
+        };
+        auto fill_south = [](Bitboard b) {
+            b |= b >> 8, b |= b >> 16, b |= b >> 32;
+            return b;
+        };
+
+        // A pawn is passed if no enemy pawn is strictly ahead of it on the
+        // same or an adjacent file
+        Bitboard span        = fill_south(shift<SOUTH>(bp));
+        e.passedPawns[WHITE] = wp & ~(span | shift<EAST>(span) | shift<WEST>(span));
+        span                 = fill_north(shift<NORTH>(wp));
+        e.passedPawns[BLACK] = bp & ~(span | shift<EAST>(span) | shift<WEST>(span));
+
+        e.pawnAttacks[WHITE] = pawn_attacks_bb<WHITE>(wp);
+        e.pawnAttacks[BLACK] = pawn_attacks_bb<BLACK>(bp);
+        e.openFiles          = ~fill_north(fill_south(wp | bp));
+        e.key                = pos.pawn_key();
+    }
+
+    std::array<Entry, Size> table{};
+};
+
+}  // namespace Stockfish
+
+#endif  // #ifndef PAWNCACHE_H_INCLUDED
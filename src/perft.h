@@ -19,10 +19,13 @@
 #ifndef PERFT_H_INCLUDED
 #define PERFT_H_INCLUDED
 
+#include <atomic>
 #include <cstdint>
+#include <vector>
 
 #include "movegen.h"
 #include "position.h"
+#include "thread.h"
 #include "types.h"
 #include "uci.h"
 
@@ -63,6 +66,56 @@ inline uint64_t perft(const std::string& fen, Depth depth, bool isChess960) {
 
     return perft<true>(p, depth);
 }
+
+// Parallel variant: splits the root moves across the given thread pool. Each
+// helper sets up its own copy of the position, claims root moves from a shared
+// cursor and runs the plain recursion below them, so the only shared state is
+// the cursor and the per-root-move counters, reduced once all threads join.
+// The per-move breakdown is printed in generation order to keep the output
+// identical to the single-threaded version.
+inline uint64_t perft(const std::string& fen, Depth depth, bool isChess960, ThreadPool& threads) {
+
+    if (threads.num_threads() <= 1 || depth <= 2)
+        return perft(fen, depth, isChess960);
+
+    StateListPtr states(new std::deque<StateInfo>(1));
+    Position     p;
+    p.set(fen, isChess960, &states->back());
+
+    const MoveList<LEGAL> rootMoves(p);
+    std::vector<uint64_t> cnt(rootMoves.size(), 0);
+    std::atomic<size_t>   cursor{0};
+
+    for (size_t i = 0; i < threads.num_threads(); ++i)
+        threads.run_on_thread(i, [&] {
+            StateListPtr rootStates(new std::deque<StateInfo>(1));
+            Position     rootPos;
+            rootPos.set(fen, isChess960, &rootStates->back());
+
+            StateInfo st;
+            ASSERT_ALIGNED(&st, Eval::NNUE::CacheLineSize);
+
+            for (size_t n = cursor.fetch_add(1); n < rootMoves.size(); n = cursor.fetch_add(1))
+            {
+                const Move m = *(rootMoves.begin() + n);
+                rootPos.do_move(m, st);
+                cnt[n] = perft<false>(rootPos, depth - 1);
+                rootPos.undo_move(m);
+            }
+        });
+
+    for (size_t i = 0; i < threads.num_threads(); ++i)
+        threads.wait_on_thread(i);
+
+    uint64_t nodes = 0;
+    for (size_t n = 0; n < rootMoves.size(); ++n)
+    {
+        sync_cout << UCIEngine::move(*(rootMoves.begin() + n), isChess960) << ": " << cnt[n]
+                  << sync_endl;
+        nodes += cnt[n];
+    }
+    return nodes;
+}
 }
 
 #endif  // PERFT_H_INCLUDED
@@ -158,7 +158,7 @@ void Position::init() {
 // Initializes the position object with the given FEN string.
 // This function is not very robust - make sure that input FENs are correct,
 // this is assumed to be the responsibility of the GUI.
-Position& Position::set(const string& fenStr, bool isChess960, StateInfo* si) {
+Position& Position::set(std::string_view fenStr, bool isChess960, StateInfo* si) {
     /*
    A FEN string defines a particular position using only the ASCII character set.
 
@@ -194,19 +194,33 @@ Position& Position::set(const string& fenStr, bool isChess960, StateInfo* si) {
       incremented after Black's move.
 */
 
-    unsigned char      col, row, token;
-    size_t             idx;
-    Square             sq = SQ_A8;
-    std::istringstream ss(fenStr);
+    unsigned char col, row, token;
+    size_t        idx;
+    Square        sq = SQ_A8;
 
     std::memset(this, 0, sizeof(Position));
     std::memset(si, 0, sizeof(StateInfo));
     st = si;
 
-    ss >> std::noskipws;
+    // The string is parsed with a plain cursor: no stream machinery and no
+    // allocation, so bulk workloads feeding millions of FENs pay only for the
+    // character scan. The StateInfo is supplied by the caller as before.
+    const char*       cur = fenStr.data();
+    const char* const end = cur + fenStr.size();
+
+    auto next = [&]() -> unsigned char { return cur < end ? *cur++ : '\0'; };
+
+    auto next_int = [&]() {
+        while (cur < end && isspace(static_cast<unsigned char>(*cur)))
+            ++cur;
+        int v = 0;
+        while (cur < end && isdigit(static_cast<unsigned char>(*cur)))
+            v = 10 * v + (*cur++ - '0');
+        return v;
+    };
 
     // 1. Piece placement
-    while ((ss >> token) && !isspace(token))
+    while ((token = next()) && !isspace(token))
     {
         if (isdigit(token))
             sq += (token - '0') * EAST;  // Advance the given number of files
@@ -222,16 +236,16 @@ Position& Position::set(const string& fenStr, bool isChess960, StateInfo* si) {
     }
 
     // 2. Active color
-    ss >> token;
+    token      = next();
     sideToMove = (token == 'w' ? WHITE : BLACK);
-    ss >> token;
+    next();  // Consume the trailing space
 
     // 3. Castling availability. Compatible with 3 standards: Normal FEN standard,
     // Shredder-FEN that uses the letters of the columns on which the rooks began
     // the game instead of KQkq and also X-FEN standard that, in case of Chess960,
     // if an inner rook is associated with the castling right, the castling tag is
     // replaced by the file letter of the involved rook, as for the Shredder-FEN.
-    while ((ss >> token) && !isspace(token))
+    while ((token = next()) && !isspace(token))
     {
         Square rsq;
         Color  c    = islower(token) ? BLACK : WHITE;
@@ -260,8 +274,8 @@ Position& Position::set(const string& fenStr, bool isChess960, StateInfo* si) {
     // Ignore if square is invalid or not on side to move relative rank 6.
     bool enpassant = false;
 
-    if (((ss >> col) && (col >= 'a' && col <= 'h'))
-        && ((ss >> row) && (row == (sideToMove == WHITE ? '6' : '3'))))
+    if (((col = next()) && (col >= 'a' && col <= 'h'))
+        && ((row = next()) && (row == (sideToMove == WHITE ? '6' : '3'))))
     {
         st->epSquare = make_square(File(col - 'a'), Rank(row - '1'));
 
@@ -278,7 +292,8 @@ Position& Position::set(const string& fenStr, bool isChess960, StateInfo* si) {
         st->epSquare = SQ_NONE;
 
     // 5-6. Halfmove clock and fullmove number
-    ss >> std::skipws >> st->rule50 >> gamePly;
+    st->rule50 = next_int();
+    gamePly    = next_int();
 
     // Convert from fullmove starting from 1 to gamePly starting from 0,
     // handle also common incorrect FEN with fullmove = 0.
@@ -677,6 +692,26 @@ bool Position::gives_check(Move m) const {
 }
 
 
+// Computes the new hash key after the given move. Needed
+// for speculative prefetch. It doesn't recognize special moves like castling,
+// en passant and promotions.
+Key Position::key_after(Move m) const {
+
+    Square from     = m.from_sq();
+    Square to       = m.to_sq();
+    Piece  pc       = piece_on(from);
+    Piece  captured = piece_on(to);
+    Key    k        = st->key ^ Zobrist::side;
+
+    if (captured)
+        k ^= Zobrist::psq[captured][to];
+
+    k ^= Zobrist::psq[pc][to] ^ Zobrist::psq[pc][from];
+
+    return (captured || type_of(pc) == PAWN) ? k : adjust_key50<true>(k);
+}
+
+
 // Makes a move, and saves all information necessary
 // to a StateInfo object. The move is assumed to be legal. Pseudo-legal
 // moves should be filtered out before this function is called.
@@ -906,6 +941,19 @@ void Position::do_move(Move                      m,
 }
 
 
+// Makes a move on a copy of the position, leaving *this untouched. Writing
+// the child into a caller-provided Position removes the undo pass entirely:
+// the copy is simply discarded when the node returns. All data members are
+// plain values, so a raw byte copy is equivalent to a memberwise one, and the
+// StateInfo chain stays valid because the parent states outlive the child.
+void Position::do_move_copy(
+  Position& dst, Move m, StateInfo& newSt, bool givesCheck, const TranspositionTable* tt) const {
+
+    std::memcpy(static_cast<void*>(&dst), static_cast<const void*>(this), sizeof(Position));
+    dst.do_move(m, newSt, givesCheck, tt);
+}
+
+
 // Unmakes a move. When it returns, the position should
 // be restored to exactly the same state as before the move was made.
 void Position::undo_move(Move m) {
@@ -1099,56 +1147,34 @@ bool Position::see_ge(Move m, int threshold) const {
 
         res ^= 1;
 
-        // Locate and remove the next least valuable attacker, and add to
-        // the bitboard 'attackers' any X-ray attackers behind it.
-        if ((bb = stmAttackers & pieces(PAWN)))
-        {
-            if ((swap = PawnValue - swap) < res)
-                break;
-            occupied ^= least_significant_square_bb(bb);
+        // Locate the next least valuable attacker with a single scan over the
+        // piece types instead of a chain of data-dependent branches; the scan
+        // always terminates because stmAttackers is known to be non-empty.
+        PieceType pt = PAWN;
+        while (!(bb = stmAttackers & pieces(pt)))
+            ++pt;
 
-            attackers |= attacks_bb<BISHOP>(to, occupied) & pieces(BISHOP, QUEEN);
-        }
+        // If we "capture" with the king but the opponent still has attackers,
+        // reverse the result.
+        if (pt == KING)
+            return (attackers & ~pieces(stm)) ? res ^ 1 : res;
 
-        else if ((bb = stmAttackers & pieces(KNIGHT)))
-        {
-            if ((swap = KnightValue - swap) < res)
-                break;
-            occupied ^= least_significant_square_bb(bb);
-        }
+        if ((swap = PieceValue[pt] - swap) < res)
+            break;
 
-        else if ((bb = stmAttackers & pieces(BISHOP)))
-        {
-            if ((swap = BishopValue - swap) < res)
-                break;
-            occupied ^= least_significant_square_bb(bb);
+        // Remove the attacker and add any X-ray attackers behind it. Whether
+        // the vacated square can hide a diagonal or an orthogonal slider is a
+        // property of the piece type, looked up from two constant masks.
+        occupied ^= least_significant_square_bb(bb);
 
-            attackers |= attacks_bb<BISHOP>(to, occupied) & pieces(BISHOP, QUEEN);
-        }
+        constexpr int XrayDiag = (1 << PAWN) | (1 << BISHOP) | (1 << QUEEN);
+        constexpr int XrayOrth = (1 << ROOK) | (1 << QUEEN);
 
-        else if ((bb = stmAttackers & pieces(ROOK)))
-        {
-            if ((swap = RookValue - swap) < res)
-                break;
-            occupied ^= least_significant_square_bb(bb);
+        if (XrayDiag & (1 << pt))
+            attackers |= attacks_bb<BISHOP>(to, occupied) & pieces(BISHOP, QUEEN);
 
+        if (XrayOrth & (1 << pt))
             attackers |= attacks_bb<ROOK>(to, occupied) & pieces(ROOK, QUEEN);
-        }
-
-        else if ((bb = stmAttackers & pieces(QUEEN)))
-        {
-            if ((swap = QueenValue - swap) < res)
-                break;
-            occupied ^= least_significant_square_bb(bb);
-
-            attackers |= (attacks_bb<BISHOP>(to, occupied) & pieces(BISHOP, QUEEN))
-                       | (attacks_bb<ROOK>(to, occupied) & pieces(ROOK, QUEEN));
-        }
-
-        else  // KING
-              // If we "capture" with the king but the opponent still has attackers,
-              // reverse the result.
-            return (attackers & ~pieces(stm)) ? res ^ 1 : res;
     }
 
     return bool(res);
@@ -1158,7 +1184,7 @@ bool Position::see_ge(Move m, int threshold) const {
 // or by repetition. It does not detect stalemates.
 bool Position::is_draw(int ply) const {
 
-    if (st->rule50 > 99 && (!checkers() || MoveList<LEGAL>(*this).size()))
+    if (st->rule50 > 99 && (!checkers() || has_legal_moves(*this)))
         return true;
 
     return is_repetition(ply);
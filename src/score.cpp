@@ -18,14 +18,79 @@
 
 #include "score.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
 
+#include "position.h"
 #include "uci.h"
 
 namespace Stockfish {
 
+namespace WDLModel {
+
+namespace {
+
+// The fitted model only uses data for material counts in [17, 78], and is
+// anchored at count 58.
+constexpr int MaterialMin = 17;
+constexpr int MaterialMax = 78;
+
+constexpr double as[] = {-37.45051876, 121.19101539, -132.78783573, 420.70576692};
+constexpr double bs[] = {90.26261072, -137.26549898, 71.10130540, 51.35259597};
+
+Params params_for(int material) {
+    double m = std::clamp(material, MaterialMin, MaterialMax) / 58.0;
+
+    double a = (((as[0] * m + as[1]) * m + as[2]) * m) + as[3];
+    double b = (((bs[0] * m + bs[1]) * m + bs[2]) * m) + bs[3];
+
+    return {a, b};
+}
+
+}
+
+int material_count(const Position& pos) {
+    return pos.count<PAWN>() + 3 * pos.count<KNIGHT>() + 3 * pos.count<BISHOP>()
+         + 5 * pos.count<ROOK>() + 9 * pos.count<QUEEN>();
+}
+
+Params win_rate_params(int material) { return params_for(material); }
+
+int win_rate(Value v, int material) {
+    auto [a, b] = params_for(material);
+    return int(0.5 + 1000 / (1 + std::exp((a - double(v)) / b)));
+}
+
+void wdl_batch(const Value* evals, const int* materials, WDLTriple* out, std::size_t count) {
+
+    // Horner over all 62 distinct clamped material counts; a short
+    // vectorizable loop that turns the per-pair polynomial into two loads.
+    constexpr int NumParams = MaterialMax - MaterialMin + 1;
+
+    double pa[NumParams], pb[NumParams];
+    for (int i = 0; i < NumParams; ++i)
+    {
+        double m = (MaterialMin + i) / 58.0;
+        pa[i]    = (((as[0] * m + as[1]) * m + as[2]) * m) + as[3];
+        pb[i]    = (((bs[0] * m + bs[1]) * m + bs[2]) * m) + bs[3];
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        int    idx = std::clamp(materials[i], MaterialMin, MaterialMax) - MaterialMin;
+        double a = pa[idx], b = pb[idx], v = double(evals[i]);
+
+        int w = int(0.5 + 1000 / (1 + std::exp((a - v) / b)));
+        int l = int(0.5 + 1000 / (1 + std::exp((a + v) / b)));
+
+        out[i] = {w, 1000 - w - l, l};
+    }
+}
+
+}
+
 Score::Score(Value v, const Position& pos) {
     assert(-VALUE_INFINITE < v && v < VALUE_INFINITE);
 
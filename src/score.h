@@ -19,6 +19,7 @@
 #ifndef SCORE_H_INCLUDED
 #define SCORE_H_INCLUDED
 
+#include <cstddef>
 #include <variant>
 #include <utility>
 
@@ -28,6 +29,40 @@ namespace Stockfish {
 
 class Position;
 
+// Win-rate model fitted against LTC fishtest statistics, see
+// github.com/official-stockfish/WDL_model. The win rate is
+// 1 / (1 + exp((a - eval) / b)), where a = p_a(material) and b = p_b(material)
+// are cubic polynomials in the material count. Used by the UCI score reporting
+// and, in batch form, by rescoring pipelines converting stored evals to WDL.
+namespace WDLModel {
+
+struct Params {
+    double a;
+    double b;
+};
+
+struct WDLTriple {
+    int win;   // All three in per mille units, summing to 1000
+    int draw;
+    int loss;
+};
+
+// Material count as used by the fitted model:
+// pawns + 3 * minors + 5 * rooks + 9 * queens, both colors
+int material_count(const Position& pos);
+
+Params win_rate_params(int material);
+
+// Win rate for the side to move, in per mille units rounded to nearest
+int win_rate(Value v, int material);
+
+// Converts 'count' (eval, material) pairs to WDL triples in one pass. The
+// polynomial coefficients are evaluated once per distinct material count, so
+// the per-pair work reduces to two sigmoids over table lookups.
+void wdl_batch(const Value* evals, const int* materials, WDLTriple* out, std::size_t count);
+
+}
+
 class Score {
    public:
     struct Mate {
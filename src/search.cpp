@@ -35,6 +35,7 @@
 
 #include "evaluate.h"
 #include "history.h"
+#include "memory.h"
 #include "misc.h"
 #include "movegen.h"
 #include "movepick.h"
@@ -47,6 +48,7 @@
 #include "thread.h"
 #include "timeman.h"
 #include "tt.h"
+#include "tune.h"
 #include "uci.h"
 #include "ucioption.h"
 
@@ -70,17 +72,44 @@ namespace {
 // so changing them or adding conditions that are similar requires
 // tests at these types of time controls.
 
+// Parameters loadable from a binary pack ('parampack' command, 'Param File'
+// option) via the Tune framework, so cluster tuning experiments swap them at
+// 'ucinewgame' without a rebuild. The initializers below stay the shipped
+// defaults; reductionScale feeds the per-worker reductions[] table, which is
+// rebuilt from it in Worker::clear().
+int futilityMultBase       = 112;
+int futilityTtCutDeduction = 26;
+int futilityMoveCountBase  = 3;
+int reductionScale         = 2143;
+int reductionBase          = 1168;
+int reductionDeltaScale    = 768;
+int reductionNonImproving  = 108;
+
+// Reductions lookup table, a pure function of reductionScale and therefore
+// shared by all workers. The registered post-update rebuilds it whenever a
+// parameter pack replaces reductionScale (load_pack, apply_snapshot);
+// Worker::clear() also calls it to cover the first use.
+std::array<int, MAX_MOVES> reductions;  // [depth or moveNumber]
+
+void update_reductions() {
+    for (size_t i = 1; i < reductions.size(); ++i)
+        reductions[i] = int(reductionScale / 100.0 * std::log(i));
+}
+
+TUNE_PACK(futilityMultBase, futilityTtCutDeduction, futilityMoveCountBase, reductionScale,
+          reductionBase, reductionDeltaScale, reductionNonImproving, update_reductions);
+
 // Futility margin
 Value futility_margin(Depth d, bool noTtCutNode, bool improving, bool oppWorsening) {
-    Value futilityMult       = 112 - 26 * noTtCutNode;
+    Value futilityMult       = futilityMultBase - futilityTtCutDeduction * noTtCutNode;
     Value improvingDeduction = improving * futilityMult * 2;
     Value worseningDeduction = oppWorsening * futilityMult / 3;
 
     return futilityMult * d - improvingDeduction - worseningDeduction;
 }
 
-constexpr int futility_move_count(bool improving, Depth depth) {
-    return (3 + depth * depth) / (2 - improving);
+inline int futility_move_count(bool improving, Depth depth) {
+    return (futilityMoveCountBase + depth * depth) / (2 - improving);
 }
 
 int correction_value(const Worker& w, const Position& pos, const Stack* const ss) {
@@ -163,6 +192,7 @@ Search::Worker::Worker(SharedState&                    sharedState,
     options(sharedState.options),
     threads(sharedState.threads),
     tt(sharedState.tt),
+    evalCache(sharedState.evalCache),
     networks(sharedState.networks),
     refreshTable(networks[token]) {
     clear();
@@ -185,7 +215,12 @@ void Search::Worker::start_searching() {
 
     main_manager()->tm.init(limits, rootPos.side_to_move(), rootPos.game_ply(), options,
                             main_manager()->originalTimeAdjust);
-    tt.new_search();
+
+    // After a mispredicted ponder, keep the generation the pondering search
+    // wrote: bumping it would age exactly the freshest entries in the table,
+    // which largely transpose into the tree we are about to search.
+    if (!limits.afterPonderMiss)
+        tt.new_search();
 
     if (rootMoves.empty())
     {
@@ -195,8 +230,16 @@ void Search::Worker::start_searching() {
     }
     else
     {
-        threads.start_searching();  // start non-main threads
-        iterative_deepening();      // main thread start searching
+        // In deterministic mode the main thread drives the whole search and
+        // the helpers stay idle: with a shared hash table even barrier-synced
+        // helpers would interleave their stores differently from run to run,
+        // so a single driver is the only arrangement that replays the exact
+        // tree. Combined with 'go nodes N' (and an equal hash state, e.g.
+        // after 'ucinewgame') the same command then always produces the same
+        // tree, score and node count, independently of the Threads setting.
+        if (!options["Deterministic"])
+            threads.start_searching();  // start non-main threads
+        iterative_deepening();          // main thread start searching
     }
 
     // When we reach the maximum depth, we can arrive here without a raise of
@@ -209,6 +252,7 @@ void Search::Worker::start_searching() {
 
     // Stop the threads if not already stopped (also raise the stop if
     // "ponderhit" just reset threads.ponder)
+    latency_note_stop();  // no-op if check_time or 'stop' already stamped it
     threads.stop = true;
 
     // Wait until all threads have finished
@@ -225,7 +269,7 @@ void Search::Worker::start_searching() {
       Skill(options["Skill Level"], options["UCI_LimitStrength"] ? int(options["UCI_Elo"]) : 0);
 
     if (int(options["MultiPV"]) == 1 && !limits.depth && !limits.mate && !skill.enabled()
-        && rootMoves[0].pv[0] != Move::none())
+        && rootMoves[0].pv[0] != Move::none() && !options["Deterministic"])
         bestThread = threads.get_best_thread()->worker.get();
 
     main_manager()->bestPreviousScore        = bestThread->rootMoves[0].score;
@@ -243,6 +287,66 @@ void Search::Worker::start_searching() {
 
     auto bestmove = UCIEngine::move(bestThread->rootMoves[0].pv[0], rootPos.is_chess960());
     main_manager()->updates.onBestmove(bestmove, ponder);
+    latency_note_bestmove();
+
+    // We are now on the opponent's time: optionally pre-touch the state the
+    // next search will start from, whichever reply arrives.
+    if (options["Speculative Warmup"] && bestThread->rootMoves[0].pv[0] != Move::none())
+        speculative_warmup(bestThread->rootMoves[0].pv[0]);
+
+    // Also on the opponent's time: once material is in probing range, eagerly
+    // walk the root-reachable tablebase positions so the next search ranks its
+    // root moves from the probe cache instead of issuing cold DTZ reads.
+    if (Tablebases::MaxCardinality > 0
+        && rootPos.count<ALL_PIECES>()
+             <= std::min(int(options["SyzygyProbeLimit"]), Tablebases::MaxCardinality)
+        && !rootPos.can_castle(ANY_CASTLING))
+        threads.warm_tb_cache(rootPos);
+}
+
+
+// Makes the move just sent as bestmove and visits the statistically likeliest
+// opponent replies, pulling their TT clusters into cache and priming the
+// accumulator refresh entries for the resulting king buckets. All of it runs
+// on the opponent's clock, so whichever reply actually arrives, the first
+// iteration of the next search starts from warm caches instead of the
+// cold-start spike after each opponent move.
+void Search::Worker::speculative_warmup(Move bestMove) {
+
+    constexpr int WarmupMoves = 8;
+
+    if (!rootPos.pseudo_legal(bestMove) || !rootPos.legal(bestMove))
+        return;
+
+    StateInfo st;
+    rootPos.do_move(bestMove, st, &tt);
+
+    const Color us = rootPos.side_to_move();
+
+    // Rank the replies with the same statistics regular move ordering uses
+    ExtMove list[MAX_MOVES];
+    ExtMove* end = generate<LEGAL>(rootPos, list);
+
+    for (ExtMove* m = list; m < end; ++m)
+        m->value = rootPos.capture_stage(*m)
+                   ? 7 * int(PieceValue[rootPos.piece_on(m->to_sq())])
+                       + captureHistory[rootPos.moved_piece(*m)][m->to_sq()]
+                                       [type_of(rootPos.piece_on(m->to_sq()))]
+                   : int(mainHistory[us][m->from_to()]);
+
+    const int count = std::min(int(end - list), WarmupMoves);
+    std::partial_sort(list, list + count, end,
+                      [](const ExtMove& a, const ExtMove& b) { return a.value > b.value; });
+
+    for (int i = 0; i < count; ++i)
+    {
+        StateInfo stReply;
+        rootPos.do_move(list[i], stReply, &tt);  // do_move() prefetches the child TT cluster
+        Eval::evaluate(networks[numaAccessToken], rootPos, refreshTable, 0);
+        rootPos.undo_move(list[i]);
+    }
+
+    rootPos.undo_move(bestMove);
 }
 
 // Main iterative deepening loop. It calls search()
@@ -305,10 +409,24 @@ void Search::Worker::iterative_deepening() {
 
     multiPV = std::min(multiPV, rootMoves.size());
 
+    // Reusing ply-1 accumulators only pays off when lines are re-entered, which
+    // happens systematically once several PV lines share the root.
+    rootAccCache.enabled = multiPV > 1;
+
     int searchAgainCounter = 0;
 
+    TimePoint iterStartTime = now();
+
+    // Read once up front: an options lookup inside the loop builds a map key
+    // and would trip the allocation guard below
+    const bool reportTimeSignals = mainThread && bool(options["Report Time Signals"]);
+
     lowPlyHistory.fill(97);
 
+    // From here on the search must not touch the heap; in debug builds any
+    // allocation aborts, see AllocGuard in memory.h
+    AllocGuard allocGuard;
+
     // Iterative deepening loop until requested to stop or the target depth is reached
     while (++rootDepth < MAX_PLY && !threads.stop
            && !(limits.depth && mainThread && rootDepth > limits.depth))
@@ -328,6 +446,10 @@ void Search::Worker::iterative_deepening() {
         if (!threads.increaseDepth)
             searchAgainCounter++;
 
+        // Aspiration re-searches this iteration, fed to the time controller
+        // below as a search-instability signal.
+        int iterFailHighLow = 0;
+
         // MultiPV loop. We perform a full root search for each PV line
         for (pvIdx = 0; pvIdx < multiPV; ++pvIdx)
         {
@@ -371,7 +493,7 @@ void Search::Worker::iterative_deepening() {
                 // and we want to keep the same order for all the moves except the
                 // new PV that goes to the front. Note that in the case of MultiPV
                 // search the already searched PV lines are preserved.
-                std::stable_sort(rootMoves.begin() + pvIdx, rootMoves.begin() + pvLast);
+                Utility::insertion_sort(rootMoves.begin() + pvIdx, rootMoves.begin() + pvLast);
 
                 // If search has been stopped, we break immediately. Sorting is
                 // safe because RootMoves is still valid, although it refers to
@@ -394,6 +516,7 @@ void Search::Worker::iterative_deepening() {
                     alpha = std::max(bestValue - delta, -VALUE_INFINITE);
 
                     failedHighCnt = 0;
+                    ++iterFailHighLow;
                     if (mainThread)
                         mainThread->stopOnPonderhit = false;
                 }
@@ -401,6 +524,7 @@ void Search::Worker::iterative_deepening() {
                 {
                     beta = std::min(bestValue + delta, VALUE_INFINITE);
                     ++failedHighCnt;
+                    ++iterFailHighLow;
                 }
                 else
                     break;
@@ -411,7 +535,7 @@ void Search::Worker::iterative_deepening() {
             }
 
             // Sort the PV lines searched so far and update the GUI
-            std::stable_sort(rootMoves.begin() + pvFirst, rootMoves.begin() + pvIdx + 1);
+            Utility::insertion_sort(rootMoves.begin() + pvFirst, rootMoves.begin() + pvIdx + 1);
 
             if (mainThread
                 && (threads.stop || pvIdx + 1 == multiPV || nodes > 10000000)
@@ -488,8 +612,13 @@ void Search::Worker::iterative_deepening() {
               (1.4540 + mainThread->previousTimeReduction) / (2.1593 * timeReduction);
             double bestMoveInstability = 0.9929 + 1.8519 * totBestMoveChanges / threads.size();
 
-            double totalTime =
-              mainThread->tm.optimum() * fallingEval * reduction * bestMoveInstability;
+            // Aspiration windows that had to be re-searched this iteration mean
+            // the score is not settled yet, so grant some extra time; conversely
+            // a clean iteration lets the factors above bank time undisturbed.
+            double searchInstability = 1.0 + 0.0467 * std::min(iterFailHighLow, 6);
+
+            double totalTime = mainThread->tm.optimum() * fallingEval * reduction
+                             * bestMoveInstability * searchInstability;
 
             // Cap used time in case of a single legal move for a better viewer experience
             if (rootMoves.size() == 1)
@@ -497,6 +626,19 @@ void Search::Worker::iterative_deepening() {
 
             auto elapsedTime = elapsed();
 
+            // Expose the controller inputs for offline tuning of the constants
+            if (reportTimeSignals)
+                sync_cout << "info string timectl depth " << rootDepth                     //
+                          << " fallingEval " << fallingEval                               //
+                          << " timeReduction " << timeReduction                           //
+                          << " bestMoveInstability " << bestMoveInstability               //
+                          << " searchInstability " << searchInstability                   //
+                          << " bestMoveChanges " << totBestMoveChanges                    //
+                          << " failHighLow " << iterFailHighLow                           //
+                          << " nodesEffort " << nodesEffort                               //
+                          << " totalTime " << TimePoint(totalTime)                        //
+                          << " elapsed " << elapsedTime << sync_endl;
+
             if (completedDepth >= 10 && nodesEffort >= 97056 && elapsedTime > totalTime * 0.6540
                 && !mainThread->ponder)
                 threads.stop = true;
@@ -517,6 +659,9 @@ void Search::Worker::iterative_deepening() {
 
         mainThread->iterValue[iterIdx] = bestValue;
         iterIdx                        = (iterIdx + 1) & 3;
+
+        latency_record(LATENCY_ITERATION, now() - iterStartTime);
+        iterStartTime = now();
     }
 
     if (!mainThread)
@@ -533,29 +678,44 @@ void Search::Worker::iterative_deepening() {
 
 // Reset histories, usually before a new game
 void Search::Worker::clear() {
-    mainHistory.fill(63);
-    lowPlyHistory.fill(108);
-    captureHistory.fill(-631);
-    pawnHistory.fill(-1210);
-    pawnCorrectionHistory.fill(0);
-    minorPieceCorrectionHistory.fill(0);
-    nonPawnCorrectionHistory[WHITE].fill(0);
-    nonPawnCorrectionHistory[BLACK].fill(0);
-
-    for (auto& to : continuationCorrectionHistory)
-        for (auto& h : to)
-            h.fill(0);
-
-    for (bool inCheck : {false, true})
-        for (StatsType c : {NoCaptures, Captures})
-            for (auto& to : continuationHistory[inCheck][c])
-                for (auto& h : to)
-                    h.fill(-479);
+    // Bumping the epoch lazily invalidates all history tables at once (see
+    // HistoryEpoch in history.h), so resetting between games is O(1). A real
+    // fill is still needed the first time, when the entries hold garbage, and
+    // whenever the 8-bit epoch wraps, so that values surviving from a full
+    // cycle ago can never alias the fresh epoch.
+    ++HistoryEpoch;
 
-    for (size_t i = 1; i < reductions.size(); ++i)
-        reductions[i] = int(2143 / 100.0 * std::log(i));
+    pawnCache.clear();
+    qsearchCache.clear();
+
+    if (!historiesInitialized || HistoryEpoch == 0)
+    {
+        historiesInitialized = true;
+
+        mainHistory.fill(ButterflyHistory::FillValue);
+        lowPlyHistory.fill(LowPlyHistory::FillValue);
+        captureHistory.fill(CapturePieceToHistory::FillValue);
+        pawnHistory.fill(PawnHistory::FillValue);
+        pawnCorrectionHistory.fill(0);
+        minorPieceCorrectionHistory.fill(0);
+        nonPawnCorrectionHistory[WHITE].fill(0);
+        nonPawnCorrectionHistory[BLACK].fill(0);
+
+        for (auto& to : continuationCorrectionHistory)
+            for (auto& h : to)
+                h.fill(0);
+
+        for (bool inCheck : {false, true})
+            for (StatsType c : {NoCaptures, Captures})
+                for (auto& to : continuationHistory[inCheck][c])
+                    for (auto& h : to)
+                        h.fill(PieceToHistory::FillValue);
+    }
+
+    update_reductions();
 
     refreshTable.clear(networks[numaAccessToken]);
+    rootAccCache.clear();
 }
 
 
@@ -655,7 +815,7 @@ Value Search::Worker::search(
     // Step 4. Transposition table lookup
     excludedMove                   = ss->excludedMove;
     posKey                         = pos.key();
-    auto [ttHit, ttData, ttWriter] = tt.probe(posKey);
+    auto [ttHit, ttData, ttWriter] = tt.probe(posKey, &thisThread->ttCache);
     // Need further processing of the saved data
     ss->ttHit    = ttHit;
     ttData.move  = rootNode ? thisThread->rootMoves[thisThread->pvIdx].pv[0]
@@ -754,12 +914,17 @@ Value Search::Worker::search(
         // Skip early pruning when in check
         ss->staticEval = eval = (ss - 2)->staticEval;
         improving             = false;
+
+        if (thisThread->nodeTrace.enabled())
+            thisThread->nodeTrace.push(posKey, (ss - 1)->currentMove, depth, alpha, beta,
+                                       ss->staticEval, ss->ttHit);
         goto moves_loop;
     }
     else if (excludedMove)
     {
         // Providing the hint that this node's accumulator will be used often
-        Eval::NNUE::hint_common_parent_position(pos, networks[numaAccessToken], refreshTable);
+        Eval::NNUE::hint_common_parent_position(pos, networks[numaAccessToken], refreshTable,
+                                                limits.smallNet);
         unadjustedStaticEval = eval = ss->staticEval;
     }
     else if (ss->ttHit)
@@ -769,7 +934,8 @@ Value Search::Worker::search(
         if (!is_valid(unadjustedStaticEval))
             unadjustedStaticEval = evaluate(pos);
         else if (PvNode)
-            Eval::NNUE::hint_common_parent_position(pos, networks[numaAccessToken], refreshTable);
+            Eval::NNUE::hint_common_parent_position(pos, networks[numaAccessToken], refreshTable,
+                                                limits.smallNet);
 
         ss->staticEval = eval = to_corrected_static_eval(unadjustedStaticEval, correctionValue);
 
@@ -788,6 +954,12 @@ Value Search::Worker::search(
                        unadjustedStaticEval, tt.generation());
     }
 
+    // Record the node once the static eval is known; nodes cut off before
+    // this point (TT, TB, draws) appear in the trace only through their parent
+    if (thisThread->nodeTrace.enabled())
+        thisThread->nodeTrace.push(posKey, (ss - 1)->currentMove, depth, alpha, beta,
+                                   ss->staticEval, ss->ttHit);
+
     // Use static evaluation difference to improve quiet move ordering
     if (((ss - 1)->currentMove).is_ok() && !(ss - 1)->inCheck && !priorCapture)
     {
@@ -950,16 +1122,46 @@ moves_loop:  // When in check, search starts here
 
 
     MovePicker mp(pos, ttData.move, depth, &thisThread->mainHistory, &thisThread->lowPlyHistory,
-                  &thisThread->captureHistory, contHist, &thisThread->pawnHistory, ss->ply);
+                  &thisThread->captureHistory, contHist, &thisThread->pawnHistory,
+                  &thisThread->pawnCache, ss->ply);
 
     value = bestValue;
 
     int moveCount = 0;
 
+    // With root work sharing enabled, helper threads defer root moves that another
+    // thread is currently searching and visit them after the rest of the move list,
+    // so the thread pool spreads over distinct root subtrees.
+    const bool shareRootWork = rootNode && threads.shareRootMoves && !is_mainthread();
+    Move       deferredMoves[MAX_MOVES];
+    int        deferredSize = 0, deferredIdx = 0;
+
+    // Claim ownership of this node for the duration of the moves loop, so
+    // concurrent threads descending the same subtree at the same time can
+    // detect the duplication before our TT write lands. A thread finding the
+    // node already claimed shuffles its move ordering towards a more reduced
+    // search instead of burning full effort on it, ABDADA-style.
+    const bool nodeOwned = !PvNode && !excludedMove && depth >= 6 && threads.size() > 1;
+    const bool nodeBusy  = nodeOwned && threads.mark_node_busy(posKey);
+
     // Step 13. Loop through all pseudo-legal moves until no moves remain
     // or a beta cutoff occurs.
-    while ((move = mp.next_move()) != Move::none())
+    while (true)
     {
+        move = mp.next_move();
+
+        bool deferred = false;
+        if (move == Move::none())
+        {
+            if (deferredIdx < deferredSize)
+            {
+                move     = deferredMoves[deferredIdx++];
+                deferred = true;
+            }
+            else
+                break;
+        }
+
         assert(move.is_ok());
 
         if (move == excludedMove)
@@ -977,10 +1179,23 @@ moves_loop:  // When in check, search starts here
                            thisThread->rootMoves.begin() + thisThread->pvLast, move))
             continue;
 
+        // Defer root moves someone else is already on, but always search the first
+        // move right away so this thread contributes to the PV move's resolution.
+        if (shareRootWork && !deferred && moveCount > 0
+            && threads.rootMoveBusy[move.from_to()].load(std::memory_order_relaxed) > 0)
+        {
+            deferredMoves[deferredSize++] = move;
+            continue;
+        }
+
         ss->moveCount = ++moveCount;
 
         if (rootNode && is_mainthread() && nodes > 10000000)
         {
+            // The GUI callback formats strings; allocation is accounted for
+            // separately from the search proper, as in SearchManager::pv()
+            AllocSuspend allocSuspend;
+
             main_manager()->updates.onIter(
               {depth, UCIEngine::move(move, pos.is_chess960()), moveCount + thisThread->pvIdx});
         }
@@ -992,6 +1207,10 @@ moves_loop:  // When in check, search starts here
         movedPiece = pos.moved_piece(move);
         givesCheck = pos.gives_check(move);
 
+        // Speculatively prefetch the TT cluster of the position after this move, so
+        // that the line is in flight while the pruning and extension logic below runs.
+        prefetch(tt.first_entry(pos.key_after(move)));
+
         // Calculate new depth for this move
         newDepth = depth - 1;
 
@@ -1117,7 +1336,11 @@ moves_loop:  // When in check, search starts here
                 // singular (multiple moves fail high), and we can prune the whole
                 // subtree by returning a softbound.
                 else if (value >= beta && !is_decisive(value))
+                {
+                    if (nodeOwned && !nodeBusy)
+                        threads.clear_node_busy(posKey);
                     return value;
+                }
 
                 // Negative extensions
                 // If other moves failed high over (ttValue - margin) without the
@@ -1144,10 +1367,19 @@ moves_loop:  // When in check, search starts here
                 extension = 1;
         }
 
+        // Publish the claim on this root move so other threads can defer it
+        if (rootNode && threads.shareRootMoves)
+            threads.rootMoveBusy[move.from_to()].fetch_add(1, std::memory_order_relaxed);
+
         // Step 16. Make the move
         pos.do_move(move, st, givesCheck, &tt);
         thisThread->nodes.fetch_add(1, std::memory_order_relaxed);
 
+        // Reuse the ply-1 feature transformer state if this root child was
+        // already visited by an earlier PV line or aspiration re-search.
+        if (rootNode && thisThread->rootAccCache.enabled)
+            thisThread->rootAccCache.restore(pos);
+
         // Add extension to new depth
         newDepth += extension;
 
@@ -1177,6 +1409,11 @@ moves_loop:  // When in check, search starts here
         if (cutNode)
             r += 2355 - (ttData.depth >= depth && ss->ttPv) * 1141;
 
+        // Increase reduction if another thread is searching this node right now;
+        // its TT write will usually arrive before our reduced search re-expands.
+        if (nodeBusy)
+            r += 1024;
+
         // Increase reduction if ttMove is a capture but the current move is not a capture
         if (ttCapture && !capture)
             r += 1087 + (depth < 8) * 990;
@@ -1266,9 +1503,15 @@ moves_loop:  // When in check, search starts here
             value = -search<PV>(pos, ss + 1, -beta, -alpha, newDepth, false);
         }
 
+        if (rootNode && thisThread->rootAccCache.enabled)
+            thisThread->rootAccCache.store(pos);
+
         // Step 19. Undo move
         pos.undo_move(move);
 
+        if (rootNode && threads.shareRootMoves)
+            threads.rootMoveBusy[move.from_to()].fetch_sub(1, std::memory_order_relaxed);
+
         assert(value > -VALUE_INFINITE && value < VALUE_INFINITE);
 
         // Step 20. Check for a new best move
@@ -1276,7 +1519,11 @@ moves_loop:  // When in check, search starts here
         // the search cannot be trusted, and we return immediately without updating
         // best move, principal variation nor transposition table.
         if (threads.stop.load(std::memory_order_relaxed))
+        {
+            if (nodeOwned && !nodeBusy)
+                threads.clear_node_busy(posKey);
             return VALUE_ZERO;
+        }
 
         if (rootNode)
         {
@@ -1380,7 +1627,7 @@ moves_loop:  // When in check, search starts here
     // must be a mate or a stalemate. If we are in a singular extension search then
     // return a fail low score.
 
-    assert(moveCount || !ss->inCheck || excludedMove || !MoveList<LEGAL>(pos).size());
+    assert(moveCount || !ss->inCheck || excludedMove || !has_legal_moves(pos));
 
     // Adjust best value for fail high cases at non-pv nodes
     if (!PvNode && bestValue >= beta && !is_decisive(bestValue) && !is_decisive(beta)
@@ -1457,6 +1704,9 @@ moves_loop:  // When in check, search starts here
 
     assert(bestValue > -VALUE_INFINITE && bestValue < VALUE_INFINITE);
 
+    if (nodeOwned && !nodeBusy)
+        threads.clear_node_busy(posKey);
+
     return bestValue;
 }
 
@@ -1518,8 +1768,21 @@ Value Search::Worker::qsearch(Position& pos, Stack* ss, Value alpha, Value beta)
     assert(0 <= ss->ply && ss->ply < MAX_PLY);
 
     // Step 3. Transposition table lookup
-    posKey                         = pos.key();
-    auto [ttHit, ttData, ttWriter] = tt.probe(posKey);
+    posKey = pos.key();
+
+    // The dedicated quiescence cache answers the non-PV early-cutoff case
+    // with a single L2-resident load before the shared table is touched,
+    // see QsearchCache in tt.h. Stored entries are always depth DEPTH_QS.
+    if (!PvNode)
+        if (QsearchCache::Entry* qe = thisThread->qsearchCache.probe(posKey))
+        {
+            Value qValue = value_from_tt(Value(qe->value16), ss->ply, pos.rule50_count());
+            if (is_valid(qValue)
+                && (qe->bound() & (qValue >= beta ? BOUND_LOWER : BOUND_UPPER)))
+                return qValue;
+        }
+
+    auto [ttHit, ttData, ttWriter] = tt.probe(posKey, &thisThread->ttCache);
     // Need further processing of the saved data
     ss->ttHit    = ttHit;
     ttData.move  = ttHit ? ttData.move : Move::none();
@@ -1544,7 +1807,7 @@ Value Search::Worker::qsearch(Position& pos, Stack* ss, Value alpha, Value beta)
             // Never assume anything about values stored in TT
             unadjustedStaticEval = ttData.eval;
             if (!is_valid(unadjustedStaticEval))
-                unadjustedStaticEval = evaluate(pos);
+                unadjustedStaticEval = evaluate(pos, alpha, beta);
             ss->staticEval = bestValue =
               to_corrected_static_eval(unadjustedStaticEval, correctionValue);
 
@@ -1556,8 +1819,9 @@ Value Search::Worker::qsearch(Position& pos, Stack* ss, Value alpha, Value beta)
         else
         {
             // In case of null move search, use previous static eval with opposite sign
-            unadjustedStaticEval =
-              (ss - 1)->currentMove != Move::null() ? evaluate(pos) : -(ss - 1)->staticEval;
+            unadjustedStaticEval = (ss - 1)->currentMove != Move::null()
+                                   ? evaluate(pos, alpha, beta)
+                                   : -(ss - 1)->staticEval;
             ss->staticEval = bestValue =
               to_corrected_static_eval(unadjustedStaticEval, correctionValue);
         }
@@ -1589,7 +1853,8 @@ Value Search::Worker::qsearch(Position& pos, Stack* ss, Value alpha, Value beta)
     // the moves. We presently use two stages of move generator in quiescence search:
     // captures, or evasions only when in check.
     MovePicker mp(pos, ttData.move, DEPTH_QS, &thisThread->mainHistory, &thisThread->lowPlyHistory,
-                  &thisThread->captureHistory, contHist, &thisThread->pawnHistory, ss->ply);
+                  &thisThread->captureHistory, contHist, &thisThread->pawnHistory,
+                  &thisThread->pawnCache, ss->ply);
 
     // Step 5. Loop through all pseudo-legal moves until no moves remain or a beta
     // cutoff occurs.
@@ -1605,6 +1870,10 @@ Value Search::Worker::qsearch(Position& pos, Stack* ss, Value alpha, Value beta)
 
         moveCount++;
 
+        // As in the main search, hide the TT probe latency of the child node
+        // behind the pruning work below.
+        prefetch(tt.first_entry(pos.key_after(move)));
+
         // Step 6. Pruning
         if (!is_loss(bestValue) && pos.non_pawn_material(us))
         {
@@ -1648,10 +1917,14 @@ Value Search::Worker::qsearch(Position& pos, Stack* ss, Value alpha, Value beta)
                 continue;
         }
 
-        // Step 7. Make and search the move
+        // Step 7. Make and search the move. Quiescence nodes never revisit
+        // the parent board after recursing, so the move is made copy-make
+        // style on a per-ply child position and the undo pass is skipped:
+        // the copy is discarded when the child returns.
         Piece movedPiece = pos.moved_piece(move);
 
-        pos.do_move(move, st, givesCheck, &tt);
+        Position childPos;
+        pos.do_move_copy(childPos, move, st, givesCheck, &tt);
         thisThread->nodes.fetch_add(1, std::memory_order_relaxed);
 
         // Update the current move
@@ -1661,8 +1934,7 @@ Value Search::Worker::qsearch(Position& pos, Stack* ss, Value alpha, Value beta)
         ss->continuationCorrectionHistory =
           &thisThread->continuationCorrectionHistory[movedPiece][move.to_sq()];
 
-        value = -qsearch<nodeType>(pos, ss + 1, -beta, -alpha);
-        pos.undo_move(move);
+        value = -qsearch<nodeType>(childPos, ss + 1, -beta, -alpha);
 
         assert(value > -VALUE_INFINITE && value < VALUE_INFINITE);
 
@@ -1691,7 +1963,7 @@ Value Search::Worker::qsearch(Position& pos, Stack* ss, Value alpha, Value beta)
     // in check and no legal moves were found, it is checkmate.
     if (ss->inCheck && bestValue == -VALUE_INFINITE)
     {
-        assert(!MoveList<LEGAL>(pos).size());
+        assert(!has_legal_moves(pos));
         return mated_in(ss->ply);  // Plies to mate from the root
     }
 
@@ -1704,14 +1976,21 @@ Value Search::Worker::qsearch(Position& pos, Stack* ss, Value alpha, Value beta)
                    bestValue >= beta ? BOUND_LOWER : BOUND_UPPER, DEPTH_QS, bestMove,
                    unadjustedStaticEval, tt.generation());
 
+    // Mirror the fully searched result into the quiescence cache. Stand-pat
+    // writes (DEPTH_UNSEARCHED) are deliberately not mirrored: they can never
+    // produce a cutoff on probe and would only evict useful entries.
+    thisThread->qsearchCache.store(posKey, bestMove, value_to_tt(bestValue, ss->ply),
+                                   bestValue >= beta ? BOUND_LOWER : BOUND_UPPER, pvHit);
+
     assert(bestValue > -VALUE_INFINITE && bestValue < VALUE_INFINITE);
 
     return bestValue;
 }
 
 Depth Search::Worker::reduction(bool i, Depth d, int mn, int delta) const {
-    int reductionScale = reductions[d] * reductions[mn];
-    return reductionScale - delta * 768 / rootDelta + !i * reductionScale * 108 / 300 + 1168;
+    int scale = reductions[d] * reductions[mn];
+    return scale - delta * reductionDeltaScale / rootDelta + !i * scale * reductionNonImproving / 300
+         + reductionBase;
 }
 
 // elapsed() returns the time elapsed since the search started. If the
@@ -1728,9 +2007,30 @@ TimePoint Search::Worker::elapsed() const {
 
 TimePoint Search::Worker::elapsed_time() const { return main_manager()->tm.elapsed_time(); }
 
-Value Search::Worker::evaluate(const Position& pos) {
-    return Eval::evaluate(networks[numaAccessToken], pos, refreshTable,
-                          optimism[pos.side_to_move()]);
+Value Search::Worker::evaluate(const Position& pos, Value alpha, Value beta) {
+    // The eval cache answers for positions whose TT entry - and the eval
+    // stored inside it - was evicted by depth-priority replacement
+    const Key key = pos.key();
+    if (Value v = evalCache.probe(key); v != VALUE_NONE)
+        return v;
+
+    // Staged evaluation: when the caller supplied its window and the PSQT
+    // half of the network alone is far outside of it, the missing positional
+    // term cannot bring the eval back, so skip the layer stack and return
+    // the PSQT-based bound. Being approximate, it is never cached.
+    constexpr Value LazyPsqtMargin = 1100;
+    if (beta != VALUE_INFINITE)
+    {
+        Value est =
+          Eval::evaluate_psqt(networks[numaAccessToken], pos, refreshTable, limits.smallNet);
+        if (est - LazyPsqtMargin >= beta || est + LazyPsqtMargin <= alpha)
+            return est;
+    }
+
+    Value v = Eval::evaluate(networks[numaAccessToken], pos, refreshTable,
+                             optimism[pos.side_to_move()], limits.smallNet);
+    evalCache.store(key, v);
+    return v;
 }
 
 namespace {
@@ -1938,7 +2238,10 @@ void SearchManager::check_time(Search::Worker& worker) {
       && ((worker.limits.use_time_management() && (elapsed > tm.maximum() || stopOnPonderhit))
           || (worker.limits.movetime && elapsed >= worker.limits.movetime)
           || (worker.limits.nodes && worker.threads.nodes_searched() >= worker.limits.nodes)))
+    {
+        latency_note_stop();
         worker.threads.stop = worker.threads.abortedSearch = true;
+    }
 }
 
 // Used to correct and extend PVs for moves that have a TB (but not a mate) score.
@@ -2082,6 +2385,10 @@ void SearchManager::pv(Search::Worker&           worker,
                        const TranspositionTable& tt,
                        Depth                     depth) {
 
+    // Formatting and the GUI callbacks are an accounted-for allocation site,
+    // measured separately from the search proper
+    AllocSuspend allocSuspend;
+
     const auto nodes     = threads.nodes_searched();
     auto&      rootMoves = worker.rootMoves;
     auto&      pos       = worker.rootPos;
@@ -2112,7 +2419,36 @@ void SearchManager::pv(Search::Worker&           worker,
             && ((!rootMoves[i].scoreLowerbound && !rootMoves[i].scoreUpperbound) || isExact))
             syzygy_extend_pv(worker.options, worker.limits, pos, rootMoves[i], v);
 
-        std::string pv;
+        // In-process embedders get the raw moves and values and we skip all
+        // string formatting below
+        if (updates.onUpdateBinary)
+        {
+            InfoBinary binfo;
+
+            binfo.depth      = d;
+            binfo.selDepth   = rootMoves[i].selDepth;
+            binfo.multiPV    = i + 1;
+            binfo.score      = v;
+            binfo.lowerbound = !isExact && rootMoves[i].scoreLowerbound;
+            binfo.upperbound = !isExact && rootMoves[i].scoreUpperbound;
+
+            TimePoint t  = std::max(TimePoint(1), tm.elapsed_time());
+            binfo.timeMs = t;
+            binfo.nodes  = nodes;
+            binfo.nps    = nodes * 1000 / t;
+            binfo.tbHits = tbHits;
+            binfo.pv     = rootMoves[i].pv.data();
+            binfo.pvLen  = rootMoves[i].pv.size();
+            binfo.hashfull = tt.hashfull();
+
+            updates.onUpdateBinary(binfo);
+            continue;
+        }
+
+        // Reuse the buffer from the previous emission, so a stable PV length
+        // means no reallocation
+        std::string& pv = pvBuffer;
+        pv.clear();
         for (Move m : rootMoves[i].pv)
             pv += UCIEngine::move(m, pos.is_chess960()) + " ";
 
@@ -2146,6 +2482,12 @@ void SearchManager::pv(Search::Worker&           worker,
 
         updates.onUpdateFull(info);
     }
+
+    if (!firstInfoEmitted)
+    {
+        firstInfoEmitted = true;
+        latency_record(LATENCY_FIRST_INFO, tm.elapsed_time());
+    }
 }
 
 // Called in case we have no ponder move before exiting the search,
@@ -34,12 +34,15 @@
 #include "history.h"
 #include "misc.h"
 #include "nnue/network.h"
+#include "nodetrace.h"
 #include "nnue/nnue_accumulator.h"
 #include "numa.h"
+#include "pawncache.h"
 #include "position.h"
 #include "score.h"
 #include "syzygy/tbprobe.h"
 #include "timeman.h"
+#include "tt.h"
 #include "types.h"
 
 namespace Stockfish {
@@ -119,6 +122,8 @@ struct LimitsType {
         movestogo = depth = mate = perft = infinite = 0;
         nodes                                       = 0;
         ponderMode                                  = false;
+        afterPonderMiss                             = false;
+        smallNet                                    = false;
     }
 
     bool use_time_management() const { return time[WHITE] || time[BLACK]; }
@@ -128,6 +133,29 @@ struct LimitsType {
     int                      movestogo, depth, mate, perft, infinite;
     uint64_t                 nodes;
     bool                     ponderMode;
+    bool                     afterPonderMiss;  // The previous 'go ponder' never got its ponderhit
+    bool                     smallNet;  // 'go smallnet': evaluate with the small network only
+};
+
+
+// Saved state of an interrupted analysis session: the root position, the last
+// completed depth and the final root move ordering with scores and PVs. The
+// histories and the hash table are not part of it (the latter can be snapshot
+// separately), but resuming with the root ordering and scores intact recovers
+// most of the work of the lost iterations. See the 'checkpoint' UCI command
+// and Engine::save_checkpoint()/load_checkpoint().
+struct Checkpoint {
+    struct RootMoveState {
+        Value             score            = -VALUE_INFINITE;
+        Value             previousScore    = -VALUE_INFINITE;
+        Value             averageScore     = -VALUE_INFINITE;
+        Value             meanSquaredScore = -VALUE_INFINITE * VALUE_INFINITE;
+        std::vector<Move> pv;
+    };
+
+    std::string                fen;
+    Depth                      depth = 0;
+    std::vector<RootMoveState> rootMoves;  // In the final search order
 };
 
 
@@ -137,15 +165,18 @@ struct SharedState {
     SharedState(const OptionsMap&                               optionsMap,
                 ThreadPool&                                     threadPool,
                 TranspositionTable&                             transpositionTable,
+                EvalCache&                                      evalHash,
                 const LazyNumaReplicated<Eval::NNUE::Networks>& nets) :
         options(optionsMap),
         threads(threadPool),
         tt(transpositionTable),
+        evalCache(evalHash),
         networks(nets) {}
 
     const OptionsMap&                               options;
     ThreadPool&                                     threads;
     TranspositionTable&                             tt;
+    EvalCache&                                      evalCache;
     const LazyNumaReplicated<Eval::NNUE::Networks>& networks;
 };
 
@@ -183,6 +214,26 @@ struct InfoIteration {
     size_t           currmovenumber;
 };
 
+// Binary form of a PV update for in-process embedders. When an onUpdateBinary
+// callback is installed, SearchManager::pv() delivers this instead of the
+// string-formatted InfoFull, skipping all ostringstream and move-to-string
+// work. The pv pointer is valid only for the duration of the callback.
+struct InfoBinary {
+    int         depth;
+    int         selDepth;
+    size_t      multiPV;
+    Value       score;
+    bool        lowerbound;
+    bool        upperbound;
+    size_t      timeMs;
+    size_t      nodes;
+    size_t      nps;
+    size_t      tbHits;
+    const Move* pv;
+    size_t      pvLen;
+    int         hashfull;
+};
+
 // Skill structure is used to implement strength limit. If we have a UCI_Elo,
 // we convert it to an appropriate skill level, anchored to the Stash engine.
 // This method is based on a fit of the Elo results for games played between
@@ -219,12 +270,14 @@ class SearchManager: public ISearchManager {
     using UpdateFull     = std::function<void(const InfoFull&)>;
     using UpdateIter     = std::function<void(const InfoIteration&)>;
     using UpdateBestmove = std::function<void(std::string_view, std::string_view)>;
+    using UpdateBinary   = std::function<void(const InfoBinary&)>;
 
     struct UpdateContext {
         UpdateShort    onUpdateNoMoves;
         UpdateFull     onUpdateFull;
         UpdateIter     onIter;
         UpdateBestmove onBestmove;
+        UpdateBinary   onUpdateBinary;
     };
 
 
@@ -248,9 +301,12 @@ class SearchManager: public ISearchManager {
     Value                bestPreviousScore;
     Value                bestPreviousAverageScore;
     bool                 stopOnPonderhit;
+    bool                 firstInfoEmitted;  // for the LATENCY_FIRST_INFO histogram
 
     size_t id;
 
+    std::string pvBuffer;  // reusable scratch for the info-line PV string
+
     const UpdateContext& updates;
 };
 
@@ -287,6 +343,12 @@ class Worker {
     ContinuationHistory   continuationHistory[2][2];
     PawnHistory           pawnHistory;
 
+    // Memoized pawn-structure masks for move ordering, see pawncache.h
+    PawnStructureCache pawnCache;
+
+    // Ring buffer of visited nodes for offline tree analysis, see nodetrace.h
+    NodeTraceBuffer nodeTrace;
+
     CorrectionHistory<Pawn>         pawnCorrectionHistory;
     CorrectionHistory<Minor>        minorPieceCorrectionHistory;
     CorrectionHistory<NonPawn>      nonPawnCorrectionHistory[COLOR_NB];
@@ -305,6 +367,10 @@ class Worker {
 
     Depth reduction(bool i, Depth d, int mn, int delta) const;
 
+    // Optional warm-up run on the opponent's time, right after bestmove is
+    // sent, visiting the likeliest replies to the chosen move.
+    void speculative_warmup(Move bestMove);
+
     // Pointer to the search manager, only allowed to be called by the main thread
     SearchManager* main_manager() const {
         assert(threadIdx == 0);
@@ -314,7 +380,11 @@ class Worker {
     TimePoint elapsed() const;
     TimePoint elapsed_time() const;
 
-    Value evaluate(const Position&);
+    // Full evaluation, through the eval cache. Callers able to tolerate an
+    // approximate answer pass their window: when the cheap PSQT half of the
+    // network is already far outside of it, the layer stack is skipped and
+    // the PSQT-based bound returned instead, see evaluate_psqt().
+    Value evaluate(const Position&, Value alpha = -VALUE_INFINITE, Value beta = VALUE_INFINITE);
 
     LimitsType limits;
 
@@ -333,8 +403,9 @@ class Worker {
     size_t                    threadIdx;
     NumaReplicatedAccessToken numaAccessToken;
 
-    // Reductions lookup table initialized at startup
-    std::array<int, MAX_MOVES> reductions;  // [depth or moveNumber]
+    // Whether the history tables were ever really filled; used by clear() to
+    // decide between an O(1) epoch bump and a full initialization.
+    bool historiesInitialized = false;
 
     // The main thread has a SearchManager, the others have a NullSearchManager
     std::unique_ptr<ISearchManager> manager;
@@ -344,11 +415,59 @@ class Worker {
     const OptionsMap&                               options;
     ThreadPool&                                     threads;
     TranspositionTable&                             tt;
+    EvalCache&                                      evalCache;
     const LazyNumaReplicated<Eval::NNUE::Networks>& networks;
 
     // Used by NNUE
     Eval::NNUE::AccumulatorCaches refreshTable;
 
+    // Per-thread L1 cache in front of the shared TT, sized by 'L1 Hash'
+    TTCache ttCache;
+
+    // Per-thread single-probe cache for quiescence nodes, enabled by
+    // 'QSearch Cache', see QsearchCache in tt.h
+    QsearchCache qsearchCache;
+
+    // Cache of big-net accumulators for the positions one ply below the root,
+    // keyed by position key. In MultiPV mode every PV line (and every aspiration
+    // re-search) re-enters the same root children, and the shared prefix of the
+    // feature transformer state can be copied back instead of being recomputed.
+    // Entries stay valid as long as the key matches, since the accumulator
+    // depends only on the position, and are invalidated in clear() when the
+    // networks may have changed.
+    struct RootAccumulatorCache {
+        struct alignas(Eval::NNUE::CacheLineSize) Entry {
+            Key key = 0;
+            Eval::NNUE::Accumulator<Eval::NNUE::TransformedFeatureDimensionsBig> acc;
+        };
+
+        bool                  enabled = false;
+        std::array<Entry, 64> entries;
+
+        void clear() {
+            for (auto& e : entries)
+                e.key = 0;
+        }
+
+        void store(const Position& pos) {
+            const auto& acc = pos.state()->accumulatorBig;
+            if (!acc.computed[WHITE] || !acc.computed[BLACK])
+                return;
+
+            Entry& e = entries[pos.key() & (entries.size() - 1)];
+            e.key    = pos.key();
+            e.acc    = acc;
+        }
+
+        void restore(Position& pos) const {
+            const Entry& e = entries[pos.key() & (entries.size() - 1)];
+            if (e.key == pos.key())
+                pos.state()->accumulatorBig = e.acc;
+        }
+    };
+
+    RootAccumulatorCache rootAccCache;
+
     friend class Stockfish::ThreadPool;
     friend class SearchManager;
 };
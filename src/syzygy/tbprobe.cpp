@@ -1334,6 +1334,74 @@ WDLScore search(Position& pos, ProbeState* result) {
 
 }  // namespace
 
+namespace {
+
+// Lockless cache of probe results in front of the table lookups, so that
+// repeated visits of the same position skip the sparse-index walk and the
+// block decompression entirely. Entries use the key ^ data validation scheme:
+// racy reads and writes from search threads are tolerated the same way as in
+// the main transposition table, a torn entry simply fails to validate.
+//
+// Packed payload: bits 0-15 dtz + 0x8000, bits 16-23 wdl + 8, bit 24 wdl
+// valid, bit 25 dtz valid, bit 63 always set so an empty entry never
+// validates.
+struct ProbeCacheEntry {
+    uint64_t keyXorData;
+    uint64_t data;
+};
+
+constexpr uint64_t ProbeCacheWdlValid = 1ULL << 24;
+constexpr uint64_t ProbeCacheDtzValid = 1ULL << 25;
+constexpr uint64_t ProbeCacheOccupied = 1ULL << 63;
+
+std::vector<ProbeCacheEntry> probeCache;
+
+bool probe_cache_lookup(Key key, uint64_t validBit, uint64_t& data) {
+
+    if (probeCache.empty())
+        return false;
+
+    const ProbeCacheEntry& e = probeCache[mul_hi64(key, probeCache.size())];
+    const uint64_t         d = e.data;
+
+    if ((e.keyXorData ^ d) != key || !(d & validBit))
+        return false;
+
+    data = d;
+    return true;
+}
+
+// Updates the field selected by 'mask', preserving the other field when the
+// entry already belongs to this key and evicting otherwise.
+void probe_cache_store(Key key, uint64_t mask, uint64_t value) {
+
+    if (probeCache.empty())
+        return;
+
+    ProbeCacheEntry& e = probeCache[mul_hi64(key, probeCache.size())];
+    uint64_t         d = e.data;
+
+    if ((e.keyXorData ^ d) != key)
+        d = 0;
+
+    d            = (d & ~mask) | value | ProbeCacheOccupied;
+    e.data       = d;
+    e.keyXorData = key ^ d;
+}
+
+int probe_dtz_uncached(Position& pos, ProbeState* result);
+
+}  // namespace
+
+
+// Sets the size, in MiB, of the probe result cache. Called on every change of
+// the "SyzygyCacheSize" UCI option, and implicitly on init(), which clears any
+// cached results belonging to previously loaded tables.
+void Tablebases::resize_cache(size_t mb) {
+    probeCache.clear();
+    probeCache.resize(mb * 1024 * 1024 / sizeof(ProbeCacheEntry));
+}
+
 
 // Called at startup and after every change to
 // "SyzygyPath" UCI option to (re)create the various tables. It is not thread
@@ -1347,6 +1415,12 @@ void Tablebases::init(const std::string& paths) {
     if (paths.empty())
         return;
 
+    // Drop results cached from any previously loaded tables, allocating the
+    // cache at its default size on first use.
+    resize_cache(probeCache.empty()
+                   ? 16
+                   : probeCache.size() * sizeof(ProbeCacheEntry) / (1024 * 1024));
+
     // MapB1H1H7[] encodes a square below a1-h8 diagonal to 0..27
     int code = 0;
     for (Square s = SQ_A1; s <= SQ_H8; ++s)
@@ -1498,7 +1572,19 @@ void Tablebases::init(const std::string& paths) {
 WDLScore Tablebases::probe_wdl(Position& pos, ProbeState* result) {
 
     *result = OK;
-    return search<false>(pos, result);
+    stats_count(STATS_TB_PROBE);
+
+    uint64_t cached;
+    if (probe_cache_lookup(pos.key(), ProbeCacheWdlValid, cached))
+        return WDLScore(int((cached >> 16) & 0xFF) - 8);
+
+    WDLScore wdl = search<false>(pos, result);
+
+    if (*result != FAIL)
+        probe_cache_store(pos.key(), 0xFF0000 | ProbeCacheWdlValid,
+                          (uint64_t(wdl + 8) << 16) | ProbeCacheWdlValid);
+
+    return wdl;
 }
 
 // Probe the DTZ table for a particular position.
@@ -1529,7 +1615,83 @@ WDLScore Tablebases::probe_wdl(Position& pos, ProbeState* result) {
 // then do not accept moves leading to dtz + 50-move-counter == 100.
 int Tablebases::probe_dtz(Position& pos, ProbeState* result) {
 
-    *result      = OK;
+    *result = OK;
+    stats_count(STATS_TB_PROBE);
+
+    uint64_t cached;
+    if (probe_cache_lookup(pos.key(), ProbeCacheDtzValid, cached))
+        return int(cached & 0xFFFF) - 0x8000;
+
+    const int dtz = probe_dtz_uncached(pos, result);
+
+    if (*result != FAIL)
+        probe_cache_store(pos.key(), 0xFFFF | ProbeCacheDtzValid,
+                          uint64_t(dtz + 0x8000) | ProbeCacheDtzValid);
+
+    return dtz;
+}
+
+
+// Eagerly probes the tablebase positions reachable from the root, filling the
+// probe result cache so that later rank_root_moves() calls hit it instead of
+// cold DTZ block reads. Intended to run on the opponent's time; it aborts as
+// soon as 'stop' is raised and is bounded by a fixed probe budget, so a 'go'
+// arriving mid-walk is delayed by at most one probe.
+void Tablebases::warm_cache(Position& pos, const std::atomic<bool>& stop) {
+
+    constexpr int ProbeBudget = 4096;
+
+    if (probeCache.empty() || MaxCardinality == 0)
+        return;
+
+    int        budget = ProbeBudget;
+    ProbeState result;
+
+    for (const Move m : MoveList<LEGAL>(pos))
+    {
+        if (stop.load(std::memory_order_relaxed) || budget <= 0)
+            return;
+
+        StateInfo st;
+        pos.do_move(m, st);
+
+        if (pos.count<ALL_PIECES>() <= MaxCardinality && !pos.can_castle(ANY_CASTLING))
+        {
+            // The same probes root_probe() will issue for this child
+            probe_wdl(pos, &result);
+            probe_dtz(pos, &result);
+            budget -= 2;
+
+            // One further ply, covering the root moves of the position the
+            // opponent's reply will put us in
+            for (const Move r : MoveList<LEGAL>(pos))
+            {
+                if (stop.load(std::memory_order_relaxed) || budget <= 0)
+                    break;
+
+                StateInfo stReply;
+                pos.do_move(r, stReply);
+
+                if (pos.count<ALL_PIECES>() <= MaxCardinality
+                    && !pos.can_castle(ANY_CASTLING))
+                {
+                    probe_wdl(pos, &result);
+                    probe_dtz(pos, &result);
+                    budget -= 2;
+                }
+
+                pos.undo_move(r);
+            }
+        }
+
+        pos.undo_move(m);
+    }
+}
+
+namespace {
+
+int probe_dtz_uncached(Position& pos, ProbeState* result) {
+
     WDLScore wdl = search<true>(pos, result);
 
     if (*result == FAIL || wdl == WDLDraw)  // DTZ tables don't store draws
@@ -1588,6 +1750,8 @@ int Tablebases::probe_dtz(Position& pos, ProbeState* result) {
     return minDTZ == 0xFFFF ? -1 : minDTZ;
 }
 
+}  // namespace
+
 
 // Use the DTZ tables to rank root moves.
 //
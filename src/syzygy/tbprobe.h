@@ -19,6 +19,7 @@
 #ifndef TBPROBE_H
 #define TBPROBE_H
 
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -64,6 +65,8 @@ extern int MaxCardinality;
 
 
 void     init(const std::string& paths);
+void     resize_cache(size_t mb);
+void     warm_cache(Position& pos, const std::atomic<bool>& stop);
 WDLScore probe_wdl(Position& pos, ProbeState* result);
 int      probe_dtz(Position& pos, ProbeState* result);
 bool     root_probe(Position& pos, Search::RootMoves& rootMoves, bool rule50, bool rankDTZ);
@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <cassert>
 #include <deque>
+#include <fstream>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -30,12 +31,46 @@
 #include "search.h"
 #include "syzygy/tbprobe.h"
 #include "timeman.h"
+#include "tt.h"
 #include "types.h"
 #include "uci.h"
 #include "ucioption.h"
 
 namespace Stockfish {
 
+namespace {
+
+inline void cpu_pause() {
+#if defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// Spins with exponential backoff on the given predicate, returning true if it
+// turned true within the spin budget. The budget is a few microseconds: long
+// enough to cover the gap between consecutive searches at fast time controls,
+// short enough that threads parked for real fall through to a blocking wait.
+template<typename Predicate>
+bool spin_wait(Predicate pred) {
+
+    for (int spent = 0, backoff = 1; spent < 4096; spent += backoff)
+    {
+        if (pred())
+            return true;
+
+        for (int i = 0; i < backoff; ++i)
+            cpu_pause();
+
+        backoff = std::min(2 * backoff, 64);
+    }
+
+    return pred();
+}
+
+}  // namespace
+
 // Constructor launches the thread and waits until it goes to sleep
 // in idle_loop(). Note that 'searching' and 'exit' should be already set.
 Thread::Thread(Search::SharedState&                    sharedState,
@@ -53,8 +88,12 @@ Thread::Thread(Search::SharedState&                    sharedState,
         // the Worker allocation. Ideally we would also allocate the SearchManager
         // here, but that's minor.
         this->numaAccessToken = binder();
-        this->worker =
-          std::make_unique<Search::Worker>(sharedState, std::move(sm), n, this->numaAccessToken);
+
+        // Remember the node for TT probing, in case a partitioned NUMA layout is active
+        TranspositionTable::set_thread_partition(this->numaAccessToken.get_numa_index());
+
+        this->worker = make_unique_large_page<Search::Worker>(sharedState, std::move(sm), n,
+                                                              this->numaAccessToken);
     });
 
     wait_for_search_finished();
@@ -65,7 +104,7 @@ Thread::Thread(Search::SharedState&                    sharedState,
 // for its termination. Thread should be already waiting.
 Thread::~Thread() {
 
-    assert(!searching);
+    assert(!searching.load());
 
     exit = true;
     start_searching();
@@ -84,22 +123,40 @@ void Thread::clear_worker() {
     run_custom_job([this]() { worker->clear(); });
 }
 
-// Blocks on the condition variable until the thread has finished searching
+// Waits until the thread has finished searching, spinning briefly before
+// falling back to the condition variable.
 void Thread::wait_for_search_finished() {
 
+    if (spin_wait([&] { return !searching.load(std::memory_order_acquire); }))
+        return;
+
     std::unique_lock<std::mutex> lk(mutex);
-    cv.wait(lk, [&] { return !searching; });
+    cv.wait(lk, [&] { return !searching.load(std::memory_order_relaxed); });
 }
 
 // Launching a function in the thread
 void Thread::run_custom_job(std::function<void()> f) {
+
+    // The thread is usually already idle or about to become so; only callers
+    // that outlast the spin budget touch the mutex. A thread is handed jobs
+    // by one thread at a time, so writing jobFunc outside the lock is safe.
+    if (!spin_wait([&] { return !searching.load(std::memory_order_acquire); }))
     {
         std::unique_lock<std::mutex> lk(mutex);
-        cv.wait(lk, [&] { return !searching; });
-        jobFunc   = std::move(f);
-        searching = true;
+        cv.wait(lk, [&] { return !searching.load(std::memory_order_relaxed); });
+    }
+
+    jobFunc = std::move(f);
+
+    // Ring the doorbell. If the thread gave up spinning and blocked, the
+    // empty lock/unlock pair ensures the store cannot land in the window
+    // between its last doorbell check and the actual wait.
+    searching.store(true, std::memory_order_seq_cst);
+    if (blocked.load(std::memory_order_seq_cst))
+    {
+        { std::lock_guard<std::mutex> lk(mutex); }
+        cv.notify_one();
     }
-    cv.notify_one();
 }
 
 void Thread::ensure_network_replicated() { worker->ensure_network_replicated(); }
@@ -110,10 +167,29 @@ void Thread::ensure_network_replicated() { worker->ensure_network_replicated();
 void Thread::idle_loop() {
     while (true)
     {
-        std::unique_lock<std::mutex> lk(mutex);
-        searching = false;
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            searching.store(false, std::memory_order_release);
+        }
         cv.notify_one();  // Wake up anyone waiting for search finished
-        cv.wait(lk, [&] { return searching; });
+
+        // Spin on the doorbell first; at fast time controls the next job
+        // arrives within the spin budget and the whole mutex/condvar/futex
+        // round trip is skipped. Announcing 'blocked' before the final
+        // doorbell check pairs with the check in run_custom_job: one side
+        // always sees the other, so the wakeup cannot be lost.
+        if (!spin_wait([&] { return searching.load(std::memory_order_acquire); }))
+        {
+            blocked.store(true, std::memory_order_seq_cst);
+
+            if (!searching.load(std::memory_order_seq_cst))
+            {
+                std::unique_lock<std::mutex> lk(mutex);
+                cv.wait(lk, [&] { return searching.load(std::memory_order_relaxed); });
+            }
+
+            blocked.store(false, std::memory_order_relaxed);
+        }
 
         if (exit)
             return;
@@ -121,8 +197,6 @@ void Thread::idle_loop() {
         std::function<void()> job = std::move(jobFunc);
         jobFunc                   = nullptr;
 
-        lk.unlock();
-
         if (job)
             job();
     }
@@ -133,6 +207,111 @@ Search::SearchManager* ThreadPool::main_manager() { return main_thread()->worker
 uint64_t ThreadPool::nodes_searched() const { return accumulate(&Search::Worker::nodes); }
 uint64_t ThreadPool::tb_hits() const { return accumulate(&Search::Worker::tbHits); }
 
+void ThreadPool::set_tt_cache_size(size_t mbSize) {
+
+    for (size_t i = 0; i < threads.size(); ++i)
+        run_on_thread(i, [this, i, mbSize]() { threads[i]->worker->ttCache.resize(mbSize); });
+
+    for (size_t i = 0; i < threads.size(); ++i)
+        wait_on_thread(i);
+}
+
+void ThreadPool::clear_tt_caches() {
+
+    for (auto&& th : threads)
+        th->worker->ttCache.clear();
+}
+
+void ThreadPool::set_qsearch_cache(bool enabled) {
+
+    for (size_t i = 0; i < threads.size(); ++i)
+        run_on_thread(i, [this, i, enabled]() { threads[i]->worker->qsearchCache.enable(enabled); });
+
+    for (size_t i = 0; i < threads.size(); ++i)
+        wait_on_thread(i);
+}
+
+void ThreadPool::set_node_trace_size(size_t mbSize) {
+
+    for (size_t i = 0; i < threads.size(); ++i)
+        run_on_thread(i, [this, i, mbSize]() { threads[i]->worker->nodeTrace.resize(mbSize); });
+
+    for (size_t i = 0; i < threads.size(); ++i)
+        wait_on_thread(i);
+}
+
+// Streams every thread's trace ring to 'file' in a simple binary format: an
+// 8-byte magic, the record size and thread count, then per thread its index,
+// record count and the records oldest-first. Host byte order throughout, the
+// offline tooling runs on the same fleet that produced the traces.
+bool ThreadPool::dump_node_trace(const std::string& file) const {
+
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    if (!out)
+        return false;
+
+    auto write_raw = [&out](const auto& v) {
+        out.write(reinterpret_cast<const char*>(&v), sizeof(v));
+    };
+
+    out.write("SFTRACE1", 8);
+    write_raw(uint32_t(sizeof(NodeTraceRecord)));
+    write_raw(uint32_t(threads.size()));
+
+    for (auto&& th : threads)
+    {
+        const NodeTraceBuffer& trace = th->worker->nodeTrace;
+
+        write_raw(uint32_t(th->id()));
+        write_raw(uint64_t(trace.count()));
+
+        for (size_t i = 0; i < trace.count(); ++i)
+            write_raw(trace.at(i));
+    }
+
+    return bool(out);
+}
+
+std::pair<uint64_t, uint64_t> ThreadPool::pawn_cache_stats() const {
+
+    uint64_t probes = 0, hits = 0;
+    for (auto&& th : threads)
+    {
+        probes += th->worker->pawnCache.probes;
+        hits += th->worker->pawnCache.hits;
+    }
+    return {probes, hits};
+}
+
+// Snapshots the main thread's root search state into a Search::Checkpoint,
+// see 'checkpoint save'. The main thread's view is used rather than the best
+// thread's: it is the one whose ordering the resumed search will rebuild.
+Search::Checkpoint ThreadPool::make_checkpoint() const {
+
+    Search::Checkpoint    ckpt;
+    const Search::Worker& worker = *main_thread()->worker;
+
+    // Before the first search rootPos has not been set up yet
+    if (worker.rootMoves.empty() || !worker.completedDepth)
+        return ckpt;
+
+    ckpt.fen   = worker.rootPos.fen();
+    ckpt.depth = worker.completedDepth;
+
+    for (const Search::RootMove& rm : worker.rootMoves)
+    {
+        Search::Checkpoint::RootMoveState saved;
+        saved.score            = rm.score;
+        saved.previousScore    = rm.previousScore;
+        saved.averageScore     = rm.averageScore;
+        saved.meanSquaredScore = rm.meanSquaredScore;
+        saved.pv               = rm.pv;
+        ckpt.rootMoves.push_back(std::move(saved));
+    }
+
+    return ckpt;
+}
+
 // Creates/destroys threads to match the requested number.
 // Created and launched threads will immediately go to sleep in idle_loop.
 // Upon resizing, threads are recreated to allow for binding if necessary.
@@ -147,6 +326,7 @@ void ThreadPool::set(const NumaConfig&                           numaConfig,
         threads.clear();
 
         boundThreadToNumaNode.clear();
+        boundThreadToCacheDomain.clear();
     }
 
     const size_t requested = sharedState.options["Threads"];
@@ -171,9 +351,17 @@ void ThreadPool::set(const NumaConfig&                           numaConfig,
             return true;
         }();
 
-        boundThreadToNumaNode = doBindThreads
-                                ? numaConfig.distribute_threads_among_numa_nodes(requested)
-                                : std::vector<NumaIndex>{};
+        // Binding happens at last-level-cache granularity: each thread gets
+        // one cache domain (a CCX on AMD, usually the whole node elsewhere)
+        // of its NUMA node, so the worker slab allocated on the bound thread
+        // and anything shared between co-located threads stay L3-local.
+        boundThreadToCacheDomain = doBindThreads
+                                   ? numaConfig.distribute_threads_among_cache_domains(requested)
+                                   : std::vector<size_t>{};
+
+        boundThreadToNumaNode.clear();
+        for (size_t d : boundThreadToCacheDomain)
+            boundThreadToNumaNode.push_back(numaConfig.cache_domain_numa_node(d));
 
         while (threads.size() < requested)
         {
@@ -187,8 +375,10 @@ void ThreadPool::set(const NumaConfig&                           numaConfig,
             // from the same NUMA node, because in case of NUMA replicated memory
             // accesses we don't want to trash cache in case the threads get scheduled
             // on the same NUMA node.
-            auto binder = doBindThreads ? OptionalThreadToNumaNodeBinder(numaConfig, numaId)
-                                        : OptionalThreadToNumaNodeBinder(numaId);
+            auto binder = doBindThreads
+                          ? OptionalThreadToNumaNodeBinder(numaConfig, numaId,
+                                                           boundThreadToCacheDomain[threadId])
+                          : OptionalThreadToNumaNodeBinder(numaId);
 
             threads.emplace_back(
               std::make_unique<Thread>(sharedState, std::move(manager), threadId, binder));
@@ -201,6 +391,52 @@ void ThreadPool::set(const NumaConfig&                           numaConfig,
 }
 
 
+// Creates (or tears down) the per-cache-domain accumulator refresh caches
+// shared by the threads bound to each domain. Each cache is constructed on a
+// thread bound to its domain, so first-touch places it on node-local memory
+// within reach of the right L3, and every worker is then pointed at the cache
+// of its own domain.
+void ThreadPool::setup_shared_refresh_tables(bool enabled) {
+
+    sharedRefreshTables.clear();
+
+    if (!enabled || threads.size() < 2)
+    {
+        for (auto&& th : threads)
+            th->worker->refreshTable.set_shared(nullptr);
+        return;
+    }
+
+    // Tables are shared at cache-domain granularity (one per CCX on AMD), so
+    // sharing never crosses an L3 boundary. When threads are not bound,
+    // boundThreadToCacheDomain is empty and all threads effectively live in
+    // domain 0, sharing a single table.
+    const auto domainOf = [this](size_t i) {
+        return i < boundThreadToCacheDomain.size() ? boundThreadToCacheDomain[i] : size_t(0);
+    };
+
+    for (size_t i = 0; i < threads.size(); ++i)
+    {
+        const size_t d = domainOf(i);
+        if (d >= sharedRefreshTables.size())
+            sharedRefreshTables.resize(d + 1);
+
+        if (!sharedRefreshTables[d])
+        {
+            run_on_thread(i, [this, i, d]() {
+                const auto& w = *threads[i]->worker;
+                sharedRefreshTables[d] =
+                  std::make_unique<Eval::NNUE::AccumulatorCaches>(w.networks[w.numaAccessToken]);
+            });
+            wait_on_thread(i);
+        }
+    }
+
+    for (size_t i = 0; i < threads.size(); ++i)
+        threads[i]->worker->refreshTable.set_shared(sharedRefreshTables[domainOf(i)].get());
+}
+
+
 // Sets threadPool data to initial values
 void ThreadPool::clear() {
     if (threads.size() == 0)
@@ -212,6 +448,24 @@ void ThreadPool::clear() {
     for (auto&& th : threads)
         th->wait_for_search_finished();
 
+    // Reset the shared refresh caches on their own cache domains, like the
+    // per-worker private ones just cleared by clear_worker()
+    std::vector<bool> domainCleared(sharedRefreshTables.size(), false);
+    for (size_t i = 0; i < threads.size(); ++i)
+    {
+        const size_t d = i < boundThreadToCacheDomain.size() ? boundThreadToCacheDomain[i] : 0;
+        if (d < sharedRefreshTables.size() && sharedRefreshTables[d] && !domainCleared[d])
+        {
+            domainCleared[d] = true;
+            auto* table      = sharedRefreshTables[d].get();
+            run_on_thread(i, [this, i, table]() {
+                const auto& w = *threads[i]->worker;
+                table->clear(w.networks[w.numaAccessToken]);
+            });
+            wait_on_thread(i);
+        }
+    }
+
     // These two affect the time taken on the first move of a game:
     main_manager()->bestPreviousAverageScore = VALUE_INFINITE;
     main_manager()->previousTimeReduction    = 0.85;
@@ -222,6 +476,45 @@ void ThreadPool::clear() {
     main_manager()->tm.clear();
 }
 
+// Schedules an eager tablebase probe cache warm-up for the given root, see
+// Tablebases::warm_cache(). With more than one thread the walk runs on the
+// last helper, which is idle between searches; a later start_thinking()
+// serializes with it naturally through run_custom_job(), and raising 'stop'
+// aborts the walk. With a single thread it runs inline, still on the
+// opponent's time.
+void ThreadPool::warm_tb_cache(const Position& pos) {
+
+    const std::string fen      = pos.fen();
+    const bool        chess960 = pos.is_chess960();
+
+    warmupAbort = false;
+
+    auto warm = [this, fen, chess960] {
+        StateInfo st;
+        Position  p;
+        p.set(fen, chess960, &st);
+        Tablebases::warm_cache(p, warmupAbort);
+    };
+
+    if (threads.size() > 1)
+        threads.back()->run_custom_job(warm);
+    else
+        warm();
+}
+
+
+// Shares the warm-up doorbell: the next 'go' (or shutdown) aborts the sweep,
+// which is safe because probe() finishes the cleanup lazily. With a single
+// thread there is nobody idle to run it, so the lazy path does all the work.
+void ThreadPool::sweep_tt(TranspositionTable& tt) {
+
+    if (threads.size() < 2)
+        return;
+
+    warmupAbort = false;
+    threads.back()->run_custom_job([this, &tt] { tt.sweep(warmupAbort); });
+}
+
 void ThreadPool::run_on_thread(size_t threadId, std::function<void()> f) {
     assert(threads.size() > threadId);
     threads[threadId]->run_custom_job(std::move(f));
@@ -237,20 +530,33 @@ size_t ThreadPool::num_threads() const { return threads.size(); }
 
 // Wakes up main thread waiting in idle_loop() and returns immediately.
 // Main thread will wake up other threads and start the search.
-void ThreadPool::start_thinking(const OptionsMap&  options,
-                                Position&          pos,
-                                StateListPtr&      states,
-                                Search::LimitsType limits) {
+void ThreadPool::start_thinking(const OptionsMap&         options,
+                                Position&                 pos,
+                                StateListPtr&             states,
+                                Search::LimitsType        limits,
+                                const Search::Checkpoint* checkpoint) {
+
+    // A pending tablebase warm-up must yield its thread to the new search
+    warmupAbort = true;
 
     main_thread()->wait_for_search_finished();
 
     main_manager()->stopOnPonderhit = stop = abortedSearch = false;
     main_manager()->ponder                                 = limits.ponderMode;
+    main_manager()->firstInfoEmitted                       = false;
 
     increaseDepth = true;
 
+    shareRootMoves = bool(options["Root Work Sharing"]) && threads.size() > 1;
+    for (auto& busy : rootMoveBusy)
+        busy.store(0, std::memory_order_relaxed);
+
+    for (auto& slot : nodeBusyTable)
+        slot.store(0, std::memory_order_relaxed);
+
     Search::RootMoves rootMoves;
-    const auto        legalmoves = MoveList<LEGAL>(pos);
+    rootMoves.reserve(MAX_MOVES);
+    const auto legalmoves = MoveList<LEGAL>(pos);
 
     for (const auto& uciMove : limits.searchmoves)
     {
@@ -266,6 +572,46 @@ void ThreadPool::start_thinking(const OptionsMap&  options,
 
     Tablebases::Config tbConfig = Tablebases::rank_root_moves(options, pos, rootMoves);
 
+    // When resuming a checkpointed session, seed the saved move ordering,
+    // scores and PVs, and skip the iterations the saved search had already
+    // completed. The histories start empty, but the root ordering carries most
+    // of the information iterative deepening would otherwise rebuild.
+    Depth startDepth = 0;
+    if (checkpoint)
+    {
+        Search::RootMoves seeded;
+        for (const auto& saved : checkpoint->rootMoves)
+        {
+            if (saved.pv.empty())
+                continue;
+
+            auto rm = std::find(rootMoves.begin(), rootMoves.end(), saved.pv[0]);
+            if (rm == rootMoves.end())
+                continue;
+
+            rm->score = rm->uciScore = saved.score;
+            rm->previousScore        = saved.previousScore;
+            rm->averageScore         = saved.averageScore;
+            rm->meanSquaredScore     = saved.meanSquaredScore;
+            rm->pv                   = saved.pv;
+            seeded.push_back(std::move(*rm));
+            rootMoves.erase(rm);
+        }
+
+        // Keep any legal moves the checkpoint does not cover, behind the seeded ones
+        for (auto& rm : rootMoves)
+            seeded.push_back(std::move(rm));
+
+        // Depth-0 seeds (e.g. book weight ordering) only reorder; resuming
+        // past completed iterations additionally needs the saved scores.
+        if (!seeded.empty()
+            && (checkpoint->depth == 0 || seeded.front().score != -VALUE_INFINITE))
+        {
+            rootMoves  = std::move(seeded);
+            startDepth = checkpoint->depth;
+        }
+    }
+
     // After ownership transfer 'states' becomes empty, so if we stop the search
     // and call 'go' again without setting a new position states.get() == nullptr.
     assert(states.get() || setupStates.get());
@@ -284,8 +630,12 @@ void ThreadPool::start_thinking(const OptionsMap&  options,
             th->worker->limits = limits;
             th->worker->nodes = th->worker->tbHits = th->worker->nmpMinPly =
               th->worker->bestMoveChanges          = 0;
-            th->worker->rootDepth = th->worker->completedDepth = 0;
+            th->worker->rootDepth = th->worker->completedDepth = startDepth;
             th->worker->rootMoves                              = rootMoves;
+            // PV updates during the search must never reallocate, see
+            // AllocGuard in memory.h
+            for (auto& rm : th->worker->rootMoves)
+                rm.pv.reserve(MAX_PLY);
             th->worker->rootPos.set(pos.fen(), pos.is_chess960(), &th->worker->rootState);
             th->worker->rootState = setupStates->back();
             th->worker->tbConfig  = tbConfig;
@@ -367,13 +717,24 @@ Thread* ThreadPool::get_best_thread() const {
 
 // Start non-main threads.
 // Will be invoked by main thread after it has started searching.
-void ThreadPool::start_searching() {
+void ThreadPool::wake_helper(size_t n) {
 
-    for (auto&& th : threads)
-        if (th != threads.front())
-            th->start_searching();
+    if (n == 0 || n >= threads.size())
+        return;
+
+    threads[n]->run_custom_job([this, n]() {
+        wake_helper(2 * n);
+        wake_helper(2 * n + 1);
+        threads[n]->worker->start_searching();
+    });
 }
 
+// Wakes the non-main threads through a binary tree of doorbells: the main
+// thread rings one helper, each woken helper rings two more before starting
+// to search. With large thread counts this turns the O(N) thundering-herd
+// wakeup in the main thread into O(log N) on its critical path.
+void ThreadPool::start_searching() { wake_helper(1); }
+
 
 // Wait for non-main threads
 void ThreadPool::wait_for_search_finished() const {
@@ -19,6 +19,7 @@
 #ifndef THREAD_H_INCLUDED
 #define THREAD_H_INCLUDED
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstddef>
@@ -26,8 +27,10 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <utility>
 #include <vector>
 
+#include "memory.h"
 #include "numa.h"
 #include "position.h"
 #include "search.h"
@@ -47,22 +50,36 @@ class OptionalThreadToNumaNodeBinder {
    public:
     OptionalThreadToNumaNodeBinder(NumaIndex n) :
         numaConfig(nullptr),
-        numaId(n) {}
+        numaId(n),
+        cacheDomainId(NoCacheDomain) {}
 
     OptionalThreadToNumaNodeBinder(const NumaConfig& cfg, NumaIndex n) :
         numaConfig(&cfg),
-        numaId(n) {}
+        numaId(n),
+        cacheDomainId(NoCacheDomain) {}
+
+    // Binds to one last-level-cache domain of the node instead of the whole
+    // node, keeping the thread and its first-touch allocations L3-local.
+    OptionalThreadToNumaNodeBinder(const NumaConfig& cfg, NumaIndex n, size_t cacheDomain) :
+        numaConfig(&cfg),
+        numaId(n),
+        cacheDomainId(cacheDomain) {}
 
     NumaReplicatedAccessToken operator()() const {
         if (numaConfig != nullptr)
-            return numaConfig->bind_current_thread_to_numa_node(numaId);
+            return cacheDomainId != NoCacheDomain
+                   ? numaConfig->bind_current_thread_to_cache_domain(cacheDomainId)
+                   : numaConfig->bind_current_thread_to_numa_node(numaId);
         else
             return NumaReplicatedAccessToken(numaId);
     }
 
    private:
+    static constexpr size_t NoCacheDomain = std::numeric_limits<size_t>::max();
+
     const NumaConfig* numaConfig;
     NumaIndex         numaId;
+    size_t            cacheDomainId;
 };
 
 // Abstraction of a thread. It contains a pointer to the worker and a native thread.
@@ -93,14 +110,25 @@ class Thread {
     void   wait_for_search_finished();
     size_t id() const { return idx; }
 
-    std::unique_ptr<Search::Worker> worker;
+    // The worker aggregates the whole per-thread search state (histories,
+    // correction tables, NNUE refresh table), so backing it with one 2MB-aligned
+    // large-page slab keeps those hot tables on a handful of TLB entries and,
+    // since it is allocated on the bound thread, on node-local memory.
+    LargePagePtr<Search::Worker> worker;
     std::function<void()>           jobFunc;
 
    private:
-    std::mutex                mutex;
-    std::condition_variable   cv;
-    size_t                    idx, nthreads;
-    bool                      exit = false, searching = true;  // Set before starting std::thread
+    std::mutex              mutex;
+    std::condition_variable cv;
+    size_t                  idx, nthreads;
+    bool                    exit = false;
+
+    // 'searching' is the doorbell: wakers spin on it before touching the
+    // mutex, and 'blocked' tells a waker whether the thread gave up spinning
+    // and needs the condition variable rung as well.
+    std::atomic<bool> searching{true};  // Set before starting std::thread
+    std::atomic<bool> blocked{false};
+
     NativeThread              stdThread;
     NumaReplicatedAccessToken numaAccessToken;
 };
@@ -117,6 +145,7 @@ class ThreadPool {
         // destroy any existing thread(s)
         if (threads.size() > 0)
         {
+            warmupAbort = true;
             main_thread()->wait_for_search_finished();
 
             threads.clear();
@@ -129,7 +158,18 @@ class ThreadPool {
     ThreadPool& operator=(const ThreadPool&) = delete;
     ThreadPool& operator=(ThreadPool&&)      = delete;
 
-    void   start_thinking(const OptionsMap&, Position&, StateListPtr&, Search::LimitsType);
+    void   start_thinking(const OptionsMap&,
+                          Position&,
+                          StateListPtr&,
+                          Search::LimitsType,
+                          const Search::Checkpoint* checkpoint = nullptr);
+    void   setup_shared_refresh_tables(bool enabled);
+    // Warms the tablebase probe cache for the given root on an idle helper
+    // thread (inline with a single thread), see Tablebases::warm_cache()
+    void   warm_tb_cache(const Position& pos);
+    // Sweeps the stale clusters left behind by TranspositionTable::
+    // rebase_clear() on an idle helper thread
+    void   sweep_tt(TranspositionTable& tt);
     void   run_on_thread(size_t threadId, std::function<void()> f);
     void   wait_on_thread(size_t threadId);
     size_t num_threads() const;
@@ -138,10 +178,38 @@ class ThreadPool {
                Search::SharedState,
                const Search::SearchManager::UpdateContext&);
 
+    // Returns ownership of the StateInfo list taken by the last
+    // start_thinking(), so the caller can keep extending the same game in
+    // place, see Engine::set_position(). Only valid between searches.
+    StateListPtr release_setup_states() { return std::move(setupStates); }
+
     Search::SearchManager* main_manager();
     Thread*                main_thread() const { return threads.front().get(); }
     uint64_t               nodes_searched() const;
     uint64_t               tb_hits() const;
+
+    // Summed pawn-structure cache {probes, hits} over all workers, see pawncache.h
+    std::pair<uint64_t, uint64_t> pawn_cache_stats() const;
+
+    // Snapshot of the main thread's root search state for 'checkpoint save'.
+    // Must only be called while no search is running.
+    Search::Checkpoint make_checkpoint() const;
+
+    // Resizes every worker's L1 TT cache (see TTCache), allocating on the
+    // owning thread so pages are first-touched locally. Pass 0 to disable.
+    void set_tt_cache_size(size_t mbSize);
+    void set_qsearch_cache(bool enabled);
+
+    // Drops all L1 TT cache contents; must be called whenever the shared
+    // table is cleared or reallocated, as slots point into it.
+    void clear_tt_caches();
+
+    // Resizes every worker's node trace ring (see nodetrace.h), allocating on
+    // the owning thread. Pass 0 to disable tracing.
+    void set_node_trace_size(size_t mbSize);
+
+    // Writes all threads' collected trace records to 'file', see 'tracedump'
+    bool dump_node_trace(const std::string& file) const;
     Thread*                get_best_thread() const;
     void                   start_searching();
     void                   wait_for_search_finished() const;
@@ -152,6 +220,43 @@ class ThreadPool {
 
     std::atomic_bool stop, abortedSearch, increaseDepth;
 
+    // Raised to cut short a pending tablebase cache warm-up ('stop' stays true
+    // between searches, so the warm-up needs its own doorbell)
+    std::atomic_bool warmupAbort{false};
+
+    // Busy counters for the optional ABDADA-style root work sharing, indexed by
+    // Move::from_to(). When enabled, helper threads defer root moves another
+    // thread is currently searching and visit them last within the iteration,
+    // so threads spread over distinct root subtrees instead of duplicating the
+    // same move ordering.
+    std::array<std::atomic<int>, 4096> rootMoveBusy;
+    bool                               shareRootMoves = false;
+
+    // Lossy ownership hint table for interior nodes, keyed by position key.
+    // A slot holds the key of a node some thread is currently looping over
+    // the moves of; a second thread entering the same node concurrently is
+    // likely duplicating that work until the TT write lands, so it can
+    // deprioritize the node. Slot collisions simply overwrite, and claims
+    // may be lost - both are fine, the table is only a hint.
+    static constexpr size_t                           NodeBusySlots = 1 << 16;
+    std::array<std::atomic<uint64_t>, NodeBusySlots>  nodeBusyTable;
+
+    // Returns true if another thread already claimed key, otherwise records
+    // the claim. The matching clear_node_busy() leaves the slot empty again.
+    bool mark_node_busy(Key key) {
+        auto& slot = nodeBusyTable[size_t(key) & (NodeBusySlots - 1)];
+        if (slot.load(std::memory_order_relaxed) == key)
+            return true;
+        slot.store(key, std::memory_order_relaxed);
+        return false;
+    }
+
+    void clear_node_busy(Key key) {
+        uint64_t expected = key;
+        nodeBusyTable[size_t(key) & (NodeBusySlots - 1)].compare_exchange_strong(
+          expected, 0, std::memory_order_relaxed);
+    }
+
     auto cbegin() const noexcept { return threads.cbegin(); }
     auto begin() noexcept { return threads.begin(); }
     auto end() noexcept { return threads.end(); }
@@ -160,9 +265,19 @@ class ThreadPool {
     auto empty() const noexcept { return threads.empty(); }
 
    private:
+    // Wakes the helper at heap index 'n' (main thread is 0, helpers 1..N-1),
+    // which first wakes its own children 2n and 2n+1 before starting to
+    // search, so a search start costs the main thread log2(N) wakeups.
+    void wake_helper(size_t n);
+
     StateListPtr                         setupStates;
     std::vector<std::unique_ptr<Thread>> threads;
     std::vector<NumaIndex>               boundThreadToNumaNode;
+    std::vector<size_t>                  boundThreadToCacheDomain;
+
+    // Optional per-NUMA-node accumulator refresh caches shared by the threads
+    // bound to each node, indexed by NumaIndex. Empty when sharing is off.
+    std::vector<std::unique_ptr<Eval::NNUE::AccumulatorCaches>> sharedRefreshTables;
 
     uint64_t accumulate(std::atomic<uint64_t> Search::Worker::*member) const {
 
@@ -18,11 +18,14 @@
 
 #include "tt.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iostream>
+#include <string>
 
 #include "memory.h"
 #include "misc.h"
@@ -104,6 +107,9 @@ void TTEntry::save(
         assert(d > DEPTH_ENTRY_OFFSET);
         assert(d < 256 + DEPTH_ENTRY_OFFSET);
 
+        if (uint16_t(k) != key16 && is_occupied())
+            stats_count(STATS_TT_OVERWRITE);
+
         key16     = uint16_t(k);
         depth8    = uint8_t(d - DEPTH_ENTRY_OFFSET);
         genBound8 = uint8_t(generation8 | uint8_t(pv) << 2 | b);
@@ -127,9 +133,78 @@ uint8_t TTEntry::relative_age(const uint8_t generation8) const {
 TTWriter::TTWriter(TTEntry* tte) :
     entry(tte) {}
 
+TTWriter::TTWriter(TTEntry* tte, TTCache::Entry* l1Slot) :
+    entry(tte),
+    l1(l1Slot) {}
+
 void TTWriter::write(
   Key k, Value v, bool pv, Bound b, Depth d, Move m, Value ev, uint8_t generation8) {
     entry->save(k, v, pv, b, d, m, ev, generation8);
+
+    // Write through to the owning thread's L1 cache, preserving the old move
+    // on same-key writes without one, as save() does for the shared entry
+    if (l1)
+    {
+        Move move = m || l1->key != k ? m : l1->data.move;
+
+        l1->key  = k;
+        l1->tte  = entry;
+        l1->data = TTData(move, v, ev, d, b, pv);
+    }
+}
+
+
+void TTCache::resize(size_t mbSize) {
+
+    table.clear();
+    table.shrink_to_fit();
+    mask = 0;
+
+    if (!mbSize)
+        return;
+
+    size_t entryCount = 1;
+    while (entryCount * 2 * sizeof(Entry) <= mbSize * 1024 * 1024)
+        entryCount *= 2;
+
+    table.assign(entryCount, Entry{});
+    mask = entryCount - 1;
+}
+
+void TTCache::clear() { std::fill(table.begin(), table.end(), Entry{}); }
+
+
+void QsearchCache::enable(bool b) {
+
+    table.clear();
+    table.shrink_to_fit();
+
+    if (b)
+        table.assign(NumEntries, Entry{});
+}
+
+void QsearchCache::clear() { std::fill(table.begin(), table.end(), Entry{}); }
+
+
+void EvalCache::resize(size_t mbSize) {
+
+    table = std::vector<std::atomic<uint64_t>>();
+    mask  = 0;
+
+    if (!mbSize)
+        return;
+
+    size_t entryCount = 1;
+    while (entryCount * 2 * sizeof(std::atomic<uint64_t>) <= mbSize * 1024 * 1024)
+        entryCount *= 2;
+
+    table = std::vector<std::atomic<uint64_t>>(entryCount);
+    mask  = entryCount - 1;
+}
+
+void EvalCache::clear() {
+    for (auto& e : table)
+        e.store(0, std::memory_order_relaxed);
 }
 
 
@@ -141,7 +216,8 @@ static constexpr int ClusterSize = 3;
 
 struct Cluster {
     TTEntry entry[ClusterSize];
-    char    padding[2];  // Pad to 32 bytes
+    uint8_t epoch;       // Table epoch the entries belong to, see rebase_clear()
+    char    padding[1];  // Pad to 32 bytes
 };
 
 static_assert(sizeof(Cluster) == 32, "Suboptimal Cluster size");
@@ -150,11 +226,46 @@ static_assert(sizeof(Cluster) == 32, "Suboptimal Cluster size");
 // Sets the size of the transposition table,
 // measured in megabytes. Transposition table consists
 // of clusters and each cluster consists of ClusterSize number of TTEntry.
+void TranspositionTable::free_table() {
+    if (mappedBytes)
+        shared_memory_unmap(table, mappedBytes);
+    else
+        aligned_large_pages_free(table);
+
+    table       = nullptr;
+    mappedBytes = 0;
+}
+
 void TranspositionTable::resize(size_t mbSize, ThreadPool& threads) {
-    aligned_large_pages_free(table);
+    // L1 cache slots point into the table being freed
+    threads.clear_tt_caches();
+
+    free_table();
 
     clusterCount = mbSize * 1024 * 1024 / sizeof(Cluster);
 
+    // When a segment name is set, back the table with named shared memory so
+    // all engine processes using the same name and size share one table. Only
+    // the process which created the segment clears it; later ones attach to
+    // the warm table as-is, which is the point of sharing.
+    if (!sharedName.empty())
+    {
+        bool created = false;
+        table        = static_cast<Cluster*>(
+          shared_memory_map(sharedName, clusterCount * sizeof(Cluster), created));
+
+        if (table)
+        {
+            mappedBytes = clusterCount * sizeof(Cluster);
+            if (created)
+                clear(threads);
+            return;
+        }
+
+        sync_cout << "info string Unable to map shared hash segment '" << sharedName
+                  << "', falling back to a private table" << sync_endl;
+    }
+
     table = static_cast<Cluster*>(aligned_large_pages_alloc(clusterCount * sizeof(Cluster)));
 
     if (!table)
@@ -166,23 +277,70 @@ void TranspositionTable::resize(size_t mbSize, ThreadPool& threads) {
     clear(threads);
 }
 
+void TranspositionTable::set_shared_name(const std::string& name) { sharedName = name; }
+
+
+// The thread's partition for TTLayout::Partitioned, set after NUMA node binding.
+// Threads which never get bound (or the UCI thread) stay on partition 0.
+static thread_local size_t threadPartition = 0;
+
+void TranspositionTable::set_layout(TTLayout newLayout, size_t numNumaNodes) {
+    layout         = newLayout;
+    partitionCount = std::max<size_t>(numNumaNodes, 1);
+}
+
+void TranspositionTable::set_thread_partition(size_t partitionIdx) {
+    threadPartition = partitionIdx;
+}
+
 
 // Initializes the entire transposition table to zero,
 // in a multi-threaded way.
 void TranspositionTable::clear(ThreadPool& threads) {
+    threads.clear_tt_caches();
+
     generation8              = 0;
+    epoch8                   = 0;  // Zeroed clusters carry epoch 0
     const size_t threadCount = threads.num_threads();
 
-    for (size_t i = 0; i < threadCount; ++i)
+    // With threads bound to NUMA nodes the clearing thread also first-touches the pages,
+    // deciding their residency. Contiguous per-thread chunks give each node one big local
+    // slice (what Partitioned probing relies on, since threads are distributed to nodes in
+    // order); Interleaved instead hands out page-sized blocks round-robin so that probe
+    // latency averages out across nodes instead of penalizing remote ones.
+    if (layout == TTLayout::Interleaved && threadCount > 1)
     {
-        threads.run_on_thread(i, [this, i, threadCount]() {
-            // Each thread will zero its part of the hash table
-            const size_t stride = clusterCount / threadCount;
-            const size_t start  = stride * i;
-            const size_t len    = i + 1 != threadCount ? stride : clusterCount - start;
-
-            std::memset(&table[start], 0, len * sizeof(Cluster));
-        });
+        // First-touch granularity. With huge pages residency is decided per huge page
+        // anyway, so a finer block size costs nothing and helps the small-pages case.
+        const size_t blockSize  = 4096 / sizeof(Cluster);
+        const size_t blockCount = (clusterCount + blockSize - 1) / blockSize;
+
+        for (size_t i = 0; i < threadCount; ++i)
+        {
+            threads.run_on_thread(i, [this, i, threadCount, blockSize, blockCount]() {
+                for (size_t b = i; b < blockCount; b += threadCount)
+                {
+                    const size_t start = b * blockSize;
+                    const size_t len   = std::min(blockSize, clusterCount - start);
+
+                    std::memset(&table[start], 0, len * sizeof(Cluster));
+                }
+            });
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < threadCount; ++i)
+        {
+            threads.run_on_thread(i, [this, i, threadCount]() {
+                // Each thread will zero its part of the hash table
+                const size_t stride = clusterCount / threadCount;
+                const size_t start  = stride * i;
+                const size_t len    = i + 1 != threadCount ? stride : clusterCount - start;
+
+                std::memset(&table[start], 0, len * sizeof(Cluster));
+            });
+        }
     }
 
     for (size_t i = 0; i < threadCount; ++i)
@@ -190,6 +348,53 @@ void TranspositionTable::clear(ThreadPool& threads) {
 }
 
 
+// Logical clear, see the comment in tt.h. A shared segment has no per-process
+// epoch to rebase, so there the physical wipe is kept.
+void TranspositionTable::rebase_clear(ThreadPool& threads) {
+
+    if (mappedBytes)
+    {
+        clear(threads);
+        return;
+    }
+
+    threads.clear_tt_caches();
+
+    // On the uint8 wrap the new epoch would collide with clusters last
+    // touched 256 clears ago, which a skipped sweep may have left behind,
+    // so fall back to the physical wipe, as Worker::clear() does for the
+    // history tables on the HistoryEpoch wrap
+    if (++epoch8 == 0)
+    {
+        clear(threads);
+        return;
+    }
+
+    generation8 = 0;
+}
+
+
+// Physically empties every cluster still tagged with an old epoch. Runs on
+// the opponent's time after a rebase clear; aborting is always safe because
+// probe() wipes whatever is left lazily on first touch.
+void TranspositionTable::sweep(const std::atomic<bool>& stop) {
+
+    constexpr size_t StopCheckInterval = 1 << 16;  // Every 2 MB
+
+    for (size_t i = 0; i < clusterCount; ++i)
+    {
+        if (i % StopCheckInterval == 0 && stop.load(std::memory_order_relaxed))
+            return;
+
+        if (table[i].epoch != epoch8)
+        {
+            std::memset(table[i].entry, 0, sizeof(table[i].entry));
+            table[i].epoch = epoch8;
+        }
+    }
+}
+
+
 // Returns an approximation of the hashtable
 // occupation during a search. The hash is x permill full, as per UCI protocol.
 // Only counts entries which match the current generation.
@@ -198,13 +403,116 @@ int TranspositionTable::hashfull(int maxAge) const {
     int cnt            = 0;
     for (int i = 0; i < 1000; ++i)
         for (int j = 0; j < ClusterSize; ++j)
-            cnt += table[i].entry[j].is_occupied()
+            cnt += table[i].epoch == epoch8 && table[i].entry[j].is_occupied()
                 && table[i].entry[j].relative_age(generation8) <= maxAgeInternal;
 
     return cnt / ClusterSize;
 }
 
 
+// On-disk snapshot format. A full snapshot is the header followed by the raw
+// cluster array; an incremental one is the header followed by (index, cluster)
+// pairs for the clusters dirtied since the previous save.
+namespace {
+
+struct TTSnapshotHeader {
+    char     magic[8];
+    uint32_t version;
+    uint8_t  generation;
+    uint8_t  incremental;
+    uint8_t  epoch;
+    uint8_t  padding[1];
+    uint64_t clusterCount;
+};
+
+constexpr char     TTSnapshotMagic[8] = {'S', 'F', 'T', 'T', 'A', 'B', 'L', 'E'};
+constexpr uint32_t TTSnapshotVersion  = 2;  // v2 added the epoch
+
+}
+
+bool TranspositionTable::save(const std::string& file, bool incremental) {
+    std::ofstream stream(file, std::ios::binary);
+    if (!stream)
+        return false;
+
+    TTSnapshotHeader header{};
+    std::memcpy(header.magic, TTSnapshotMagic, sizeof(header.magic));
+    header.version      = TTSnapshotVersion;
+    header.generation   = generation8;
+    header.incremental  = incremental;
+    header.epoch        = epoch8;
+    header.clusterCount = clusterCount;
+
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    if (!incremental)
+        stream.write(reinterpret_cast<const char*>(table), clusterCount * sizeof(Cluster));
+    else
+    {
+        // An entry is considered dirty if it was written after the previous save,
+        // i.e. its age is smaller than the number of generations elapsed since
+        // then. After GENERATION_CYCLE generations the ages wrap and the test
+        // over-approximates towards a full save, which is safe.
+        const uint8_t elapsed =
+          (GENERATION_CYCLE + generation8 - generationAtLastSave) & GENERATION_MASK;
+
+        for (uint64_t i = 0; i < clusterCount; ++i)
+        {
+            // Clusters from an older epoch are logically empty, never dirty
+            bool dirty = false;
+            for (int j = 0; j < ClusterSize && !dirty; ++j)
+                dirty = table[i].epoch == epoch8 && table[i].entry[j].is_occupied()
+                     && table[i].entry[j].relative_age(generation8) < elapsed;
+
+            if (dirty)
+            {
+                stream.write(reinterpret_cast<const char*>(&i), sizeof(i));
+                stream.write(reinterpret_cast<const char*>(&table[i]), sizeof(Cluster));
+            }
+        }
+    }
+
+    if (stream)
+        generationAtLastSave = generation8;
+
+    return bool(stream);
+}
+
+bool TranspositionTable::load(const std::string& file) {
+    std::ifstream stream(file, std::ios::binary);
+    if (!stream)
+        return false;
+
+    TTSnapshotHeader header{};
+    stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    if (!stream || std::memcmp(header.magic, TTSnapshotMagic, sizeof(header.magic)) != 0
+        || header.version != TTSnapshotVersion || header.clusterCount != clusterCount)
+        return false;
+
+    if (!header.incremental)
+        stream.read(reinterpret_cast<char*>(table), clusterCount * sizeof(Cluster));
+    else
+    {
+        uint64_t i;
+        while (stream.read(reinterpret_cast<char*>(&i), sizeof(i)))
+        {
+            if (i >= clusterCount || !stream.read(reinterpret_cast<char*>(&table[i]),
+                                                  sizeof(Cluster)))
+                return false;
+        }
+    }
+
+    // Adopt the snapshot's generation and epoch so the stored entry ages and
+    // the cluster tags stay exact
+    generation8          = header.generation;
+    generationAtLastSave = generation8;
+    epoch8               = header.epoch;
+
+    return !stream.bad();
+}
+
+
 void TranspositionTable::new_search() {
     // increment by delta to keep lower bits as is
     generation8 += GENERATION_DELTA;
@@ -225,11 +533,30 @@ std::tuple<bool, TTData, TTWriter> TranspositionTable::probe(const Key key) cons
     TTEntry* const tte   = first_entry(key);
     const uint16_t key16 = uint16_t(key);  // Use the low 16 bits as key inside the cluster
 
+    stats_count(STATS_TT_PROBE);
+
+    // First touch after a rebase clear: the cluster still holds the previous
+    // epoch's entries, so physically empty it now. Concurrent wipes write the
+    // same bytes, no worse a race than the unprotected saves below.
+    Cluster* const cluster = reinterpret_cast<Cluster*>(tte);
+    if (cluster->epoch != epoch8)
+    {
+        std::memset(cluster->entry, 0, sizeof(cluster->entry));
+        cluster->epoch = epoch8;
+
+        return {false,
+                TTData{Move::none(), VALUE_NONE, VALUE_NONE, DEPTH_ENTRY_OFFSET, BOUND_NONE, false},
+                TTWriter(tte)};
+    }
+
     for (int i = 0; i < ClusterSize; ++i)
         if (tte[i].key16 == key16)
+        {
+            stats_count(STATS_TT_HIT);
             // This gap is the main place for read races.
             // After `read()` completes that copy is final, but may be self-inconsistent.
             return {tte[i].is_occupied(), tte[i].read(), TTWriter(&tte[i])};
+        }
 
     // Find an entry to be replaced according to the replacement strategy
     TTEntry* replace = tte;
@@ -244,7 +571,49 @@ std::tuple<bool, TTData, TTWriter> TranspositionTable::probe(const Key key) cons
 }
 
 
+// Probes the caller's L1 cache before the shared table. An L1 hit skips the
+// shared cluster scan (and, at large table sizes, its DRAM or remote-socket
+// access) entirely; a miss falls through and refills the slot. The returned
+// writer carries the slot so results are written through.
+std::tuple<bool, TTData, TTWriter> TranspositionTable::probe(const Key key, TTCache* l1) const {
+
+    TTCache::Entry* slot = l1 ? l1->slot(key) : nullptr;
+
+    if (slot && slot->key == key)
+    {
+        stats_count(STATS_TT_HIT);
+        return {true, slot->data, TTWriter(slot->tte, slot)};
+    }
+
+    auto [hit, data, writer] = probe(key);
+
+    if (slot)
+    {
+        writer.l1 = slot;
+
+        if (hit)
+        {
+            slot->key  = key;
+            slot->tte  = writer.entry;
+            slot->data = data;
+        }
+    }
+
+    return {hit, data, writer};
+}
+
+
 TTEntry* TranspositionTable::first_entry(const Key key) const {
+    if (layout == TTLayout::Partitioned && partitionCount > 1)
+    {
+        // Each thread hashes into its NUMA node's slice only. Entries are no longer shared
+        // across nodes, trading some duplicated work for node-local probes throughout.
+        const size_t sliceCount = clusterCount / partitionCount;
+        const size_t base       = (threadPartition % partitionCount) * sliceCount;
+
+        return &table[base + mul_hi64(key, sliceCount)].entry[0];
+    }
+
     return &table[mul_hi64(key, clusterCount)].entry[0];
 }
 
@@ -19,9 +19,12 @@
 #ifndef TT_H_INCLUDED
 #define TT_H_INCLUDED
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <string>
 #include <tuple>
+#include <vector>
 
 #include "memory.h"
 #include "types.h"
@@ -32,6 +35,16 @@ class ThreadPool;
 struct TTEntry;
 struct Cluster;
 
+// Memory layout policy for the cluster storage on NUMA systems. The table is always one
+// flat allocation; the layout only controls which thread first-touches which pages during
+// clear() (and, for Partitioned, which slice of the table a thread probes), so that page
+// residency follows the NUMA node binding of the threads that clear and probe them.
+enum class TTLayout {
+    Flat,         // contiguous per-thread first-touch, as if no layout policy existed
+    Interleaved,  // pages are first-touched round-robin across the clearing threads
+    Partitioned   // each thread probes only the slice local to its NUMA node
+};
+
 // There is only one global hash table for the engine and all its threads. For chess in particular, we even allow racy
 // updates between threads to and from the TT, as taking the time to synchronize access would cost thinking time and
 // thus elo. As a hash table, collisions are possible and may cause chess playing issues (bizarre blunders, faulty mate
@@ -66,6 +79,115 @@ struct TTData {
 };
 
 
+// Optional small per-thread cache probed in front of the shared table, sized
+// to fit a core's slice of L3. Slots are filled from shared-table hits and
+// kept coherent for the owning thread by write-through in TTWriter::write().
+// Writes by other threads are not seen until the slot is refilled, and the
+// remembered shared-entry pointer may meanwhile have been retargeted to a
+// different position - both are the same lossiness the racy shared table
+// already tolerates. A zero size disables the cache.
+class TTCache {
+   public:
+    struct Entry {
+        Key      key = 0;
+        TTEntry* tte = nullptr;
+        TTData   data{Move::none(), VALUE_NONE, VALUE_NONE, DEPTH_ENTRY_OFFSET, BOUND_NONE, false};
+    };
+
+    void resize(size_t mbSize);  // Pass 0 to disable
+    void clear();
+
+    Entry* slot(Key key) { return table.empty() ? nullptr : &table[size_t(key) & mask]; }
+
+   private:
+    std::vector<Entry> table;
+    size_t             mask = 0;
+};
+
+
+// Optional per-thread cache dedicated to quiescence nodes, probed in
+// Search::Worker::qsearch before the shared table. Quiescence nodes dominate
+// the node count but their entries rarely survive long under depth-priority
+// replacement, so they pay the full 3-way cluster probe for little return. A
+// packed single-probe 8-byte entry keeps the whole cache L2-resident and
+// answers the common repeated probes with one load. Entries carry no static
+// eval and no generation: the cache is always-replace, stores only fully
+// searched (DEPTH_QS) results, and a hit only short-circuits the non-PV
+// early-cutoff case - everything else falls through to the shared table.
+class QsearchCache {
+   public:
+    struct Entry {
+        uint16_t key16;
+        uint16_t move16;
+        int16_t  value16;
+        uint8_t  flags;  // Bound in bits 0-1, PV flag in bit 2
+        uint8_t  used;   // Distinguishes an empty slot from key16 == 0
+
+        Bound bound() const { return Bound(flags & 0x3); }
+        bool  is_pv() const { return flags & 0x4; }
+    };
+    static_assert(sizeof(Entry) == 8);
+
+    void enable(bool b);  // (Re-)allocates or drops the table
+    void clear();
+
+    Entry* probe(Key key) {
+        if (table.empty())
+            return nullptr;
+        Entry* e = &table[size_t(key >> 16) & (NumEntries - 1)];
+        return e->used && e->key16 == uint16_t(key) ? e : nullptr;
+    }
+
+    void store(Key key, Move m, Value v, Bound b, bool pv) {
+        if (table.empty())
+            return;
+        table[size_t(key >> 16) & (NumEntries - 1)] =
+          Entry{uint16_t(key), m.raw(), int16_t(v), uint8_t(b | (pv << 2)), 1};
+    }
+
+   private:
+    // 32K entries = 256KB, fitting comfortably in one core's L2
+    static constexpr size_t NumEntries = 32 * 1024;
+
+    std::vector<Entry> table;
+};
+
+
+// Shared always-replace cache of static evaluations, sized by the
+// 'Eval Cache' option. The shared table stores the eval alongside the search
+// data, so depth-priority replacement evicts both together and the eval of
+// an evicted position has to be recomputed even though it was perfectly
+// reusable. Entries here are a single word - the upper 48 bits of the
+// position key over the eval in the lower 16 - so concurrent access needs
+// only relaxed atomics and can never tear. Stored values carry the storing
+// thread's optimism and rule50 damping, the same staleness TTEntry's eval
+// field already tolerates.
+class EvalCache {
+   public:
+    void resize(size_t mbSize);  // Pass 0 to disable
+    void clear();
+
+    Value probe(Key key) const {
+        if (table.empty())
+            return VALUE_NONE;
+        uint64_t e = table[size_t(key) & mask].load(std::memory_order_relaxed);
+        // A zero word doubles as the empty slot; it aliases a real entry only
+        // for an eval of 0 under a key with 48 zero high bits
+        return e && (e >> 16) == (key >> 16) ? Value(int16_t(e)) : VALUE_NONE;
+    }
+
+    void store(Key key, Value v) {
+        if (!table.empty())
+            table[size_t(key) & mask].store((key & ~uint64_t(0xFFFF)) | uint16_t(int16_t(v)),
+                                            std::memory_order_relaxed);
+    }
+
+   private:
+    std::vector<std::atomic<uint64_t>> table;
+    size_t                             mask = 0;
+};
+
+
 // This is used to make racy writes to the global TT.
 struct TTWriter {
    public:
@@ -73,18 +195,51 @@ struct TTWriter {
 
    private:
     friend class TranspositionTable;
-    TTEntry* entry;
+    TTEntry*        entry;
+    TTCache::Entry* l1 = nullptr;  // Write-through target, may be nullptr
     TTWriter(TTEntry* tte);
+    TTWriter(TTEntry* tte, TTCache::Entry* l1Slot);
 };
 
 
 class TranspositionTable {
 
    public:
-    ~TranspositionTable() { aligned_large_pages_free(table); }
+    ~TranspositionTable() { free_table(); }
 
     void resize(size_t mbSize, ThreadPool& threads);  // Set TT size
     void clear(ThreadPool& threads);                  // Re-initialize memory, multithreaded
+
+    // Logical clear at constant cost: advancing the table epoch makes probe()
+    // treat every existing cluster as empty, so 'ucinewgame' costs
+    // microseconds instead of a blocking full-table wipe. Stale clusters are
+    // physically emptied lazily on first touch and by sweep(), which
+    // ThreadPool::sweep_tt() runs on an idle thread between searches.
+    void rebase_clear(ThreadPool& threads);
+    void sweep(const std::atomic<bool>& stop);
+
+    // Persistence, for warm-starting repeated analysis of the same lines. save()
+    // streams the clusters to disk with the current generation recorded in the
+    // header, so ages are preserved exactly on load(). An incremental save only
+    // writes clusters containing at least one entry written since the previous
+    // save, to be applied on top of an earlier full snapshot. A full snapshot
+    // can only be loaded into a table of the same size, as entries keep just 16
+    // bits of their key and cannot be rehashed.
+    bool save(const std::string& file, bool incremental);
+    bool load(const std::string& file);
+
+    // Select the NUMA layout policy. Takes effect on the next resize()/clear(), so the
+    // caller is expected to trigger a reallocation to re-touch the pages accordingly.
+    void set_layout(TTLayout newLayout, size_t numNumaNodes);
+    // Names a shared-memory segment to back the table with, so cooperating
+    // engine processes on one host share a single table; the lockless XOR
+    // validation in TTEntry handles cross-process races the same way it
+    // handles cross-thread ones. An empty name (the default) keeps the table
+    // process-private. Takes effect on the next resize().
+    void set_shared_name(const std::string& name);
+    // Records, for the calling thread, which partition first_entry() should use in
+    // Partitioned mode. Called once per search thread after NUMA node binding.
+    static void set_thread_partition(size_t partitionIdx);
     int  hashfull(int maxAge = 0)
       const;  // Approximate what fraction of entries (permille) have been written to during this root search
 
@@ -93,16 +248,28 @@ class TranspositionTable {
     uint8_t generation() const;  // The current age, used when writing new data to the TT
     std::tuple<bool, TTData, TTWriter>
     probe(const Key key) const;  // The main method, whose retvals separate local vs global objects
+    std::tuple<bool, TTData, TTWriter>
+    probe(const Key key, TTCache* l1) const;  // As above, but checking a per-thread L1 cache first
     TTEntry* first_entry(const Key key)
       const;  // This is the hash function; its only external use is memory prefetching.
 
    private:
     friend struct TTEntry;
 
+    void free_table();
+
     size_t   clusterCount;
     Cluster* table = nullptr;
 
+    TTLayout layout         = TTLayout::Flat;
+    size_t   partitionCount = 1;  // Number of NUMA nodes the table is split across
+
+    std::string sharedName;       // Shared-memory segment name, empty for private tables
+    size_t      mappedBytes = 0;  // Nonzero while the table is a shared mapping
+
     uint8_t generation8 = 0;  // Size must be not bigger than TTEntry::genBound8
+    uint8_t generationAtLastSave = 0;  // Reference point for incremental snapshots
+    uint8_t epoch8               = 0;  // Clusters tagged with an older epoch read as empty
 };
 
 }  // namespace Stockfish
@@ -19,11 +19,15 @@
 #include "tune.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
 #include <map>
 #include <optional>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "ucioption.h"
 
@@ -89,12 +93,13 @@ string Tune::next(string& names, bool pop) {
 
 template<>
 void Tune::Entry<int>::init_option() {
-    make_option(options, name, value, range);
+    if (!packOnly)
+        make_option(options, name, value, range);
 }
 
 template<>
 void Tune::Entry<int>::read_option() {
-    if (options->count(name))
+    if (!packOnly && options->count(name))
         value = int((*options)[name]);
 }
 
@@ -106,6 +111,118 @@ void Tune::Entry<Tune::PostUpdate>::read_option() {
     value();
 }
 
+bool Tune::save_pack(const string& file) {
+
+    std::ofstream out(file, std::ios::binary);
+    if (!out)
+        return false;
+
+    auto write_raw = [&out](const auto& v) {
+        out.write(reinterpret_cast<const char*>(&v), sizeof(v));
+    };
+
+    std::uint32_t count = 0;
+    for (const auto& e : instance().list)
+        if (int v; e->pack_value(v))
+            ++count;
+
+    out.write("SFPARAM1", 8);
+    write_raw(count);
+
+    for (const auto& e : instance().list)
+        if (int v; e->pack_value(v))
+        {
+            std::uint16_t len = std::uint16_t(e->name.size());
+            write_raw(len);
+            out.write(e->name.data(), len);
+            write_raw(std::int32_t(v));
+        }
+
+    return bool(out);
+}
+
+bool Tune::load_pack(const string& file) {
+
+    std::ifstream in(file, std::ios::binary);
+    if (!in)
+        return false;
+
+    auto read_raw = [&in](auto& v) { in.read(reinterpret_cast<char*>(&v), sizeof(v)); };
+
+    char magic[8];
+    in.read(magic, 8);
+    if (!in || string(magic, 8) != "SFPARAM1")
+        return false;
+
+    std::uint32_t count;
+    read_raw(count);
+
+    // Stage everything first: a file naming an unknown parameter is rejected
+    // as a whole, so the engine never runs on a half-applied set
+    std::vector<std::pair<EntryBase*, int>> staged;
+
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        std::uint16_t len;
+        read_raw(len);
+
+        string name(len, '\0');
+        in.read(name.data(), len);
+
+        std::int32_t v;
+        read_raw(v);
+
+        if (!in)
+            return false;
+
+        EntryBase* entry = nullptr;
+        for (const auto& e : instance().list)
+            if (int cur; e->name == name && e->pack_value(cur))
+            {
+                entry = e.get();
+                break;
+            }
+
+        if (!entry)
+            return false;
+
+        staged.emplace_back(entry, int(v));
+    }
+
+    for (const auto& [entry, v] : staged)
+        entry->pack_apply(v);
+
+    // Run the post-update functions (and any live tuning options) so derived
+    // tables are rebuilt from the new values
+    read_options();
+
+    return true;
+}
+
+std::vector<int> Tune::snapshot_pack() {
+
+    std::vector<int> values;
+    for (const auto& e : instance().list)
+        if (int v; e->pack_value(v))
+            values.push_back(v);
+
+    return values;
+}
+
+void Tune::apply_snapshot(const std::vector<int>& values) {
+
+    size_t i = 0;
+    for (const auto& e : instance().list)
+        if (int cur; e->pack_value(cur) && i < values.size())
+            e->pack_apply(values[i++]);
+
+    // Run only the post-update functions: unlike read_options(), the UCI
+    // options must not overwrite the values that were just applied
+    for (const auto& e : instance().list)
+        if (int v; !e->pack_value(v))
+            e->read_option();
+}
+
 }  // namespace Stockfish
 
 
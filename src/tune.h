@@ -92,9 +92,19 @@ class Tune {
 
     // Use polymorphism to accommodate Entry of different types in the same vector
     struct EntryBase {
+        explicit EntryBase(const std::string& n) :
+            name(n) {}
         virtual ~EntryBase()       = default;
         virtual void init_option() = 0;
         virtual void read_option() = 0;
+
+        // Parameter-pack access: current value and bulk update, false for
+        // entries that are not plain int parameters (post-update functions)
+        virtual bool pack_value(int& v) const = 0;
+        virtual bool pack_apply(int v)        = 0;
+
+        std::string name;
+        bool        packOnly = false;  // Registered with TUNE_PACK: no UCI option
     };
 
     template<typename T>
@@ -106,16 +116,34 @@ class Tune {
                       "Parameter type not supported!");
 
         Entry(const std::string& n, T& v, const SetRange& r) :
-            name(n),
+            EntryBase(n),
             value(v),
             range(r) {}
         void operator=(const Entry&) = delete;  // Because 'value' is a reference
         void init_option() override;
         void read_option() override;
 
-        std::string name;
-        T&          value;
-        SetRange    range;
+        bool pack_value(int& v) const override {
+            if constexpr (std::is_same_v<T, int>)
+            {
+                v = value;
+                return true;
+            }
+            else
+                return (void) v, false;
+        }
+        bool pack_apply(int v) override {
+            if constexpr (std::is_same_v<T, int>)
+            {
+                value = v;
+                return true;
+            }
+            else
+                return (void) v, false;
+        }
+
+        T&       value;
+        SetRange range;
     };
 
     // Our facility to fill the container, each Entry corresponds to a parameter
@@ -128,6 +156,7 @@ class Tune {
     template<typename T, typename... Args>
     int add(const SetRange& range, std::string&& names, T& value, Args&&... args) {
         list.push_back(std::unique_ptr<EntryBase>(new Entry<T>(next(names), value, range)));
+        list.back()->packOnly = registeringPack;
         return add(range, std::move(names), args...);
     }
 
@@ -149,12 +178,43 @@ class Tune {
 
     std::vector<std::unique_ptr<EntryBase>> list;
 
+    bool registeringPack = false;  // True while inside add_pack()
+
    public:
     template<typename... Args>
     static int add(const std::string& names, Args&&... args) {
         return instance().add(SetDefaultRange, names.substr(1, names.size() - 2),
                               args...);  // Remove trailing parenthesis
     }
+
+    // Like add(), but the parameters become pack-only: no UCI option is
+    // generated and nothing is printed, so TUNE_PACK registrations can stay
+    // in shipping builds. The compiled-in initializers are the defaults;
+    // load_pack() replaces them wholesale from a parameter-pack file.
+    template<typename... Args>
+    static int add_pack(const std::string& names, Args&&... args) {
+        instance().registeringPack = true;
+        int r = instance().add(SetDefaultRange, names.substr(1, names.size() - 2), args...);
+        instance().registeringPack = false;
+        return r;
+    }
+
+    // Binary parameter packs: 'SFPARAM1' magic, a record count, then
+    // {name, int32 value} records. save_pack() writes the currently active
+    // values of every int parameter; load_pack() validates the whole file
+    // against the registered names first and then applies all values and
+    // runs the post-update functions, so a bad file changes nothing.
+    static bool save_pack(const std::string& file);
+    static bool load_pack(const std::string& file);
+
+    // In-memory counterpart of the pack files, used by 'tunematch' to swap
+    // whole parameter sets between moves without filesystem round-trips.
+    // snapshot_pack() collects the current value of every int parameter in
+    // registration order; apply_snapshot() writes such a snapshot back and
+    // runs the post-update functions. UCI options are deliberately left
+    // untouched: while a match runs, the snapshot is the authority.
+    static std::vector<int> snapshot_pack();
+    static void             apply_snapshot(const std::vector<int>& values);
     static void init(OptionsMap& o) {
         options = &o;
         for (auto& e : instance().list)
@@ -176,6 +236,8 @@ class Tune {
 #define UNIQUE(x, y) UNIQUE2(x, y)  // Two indirection levels to expand __LINE__
 #define TUNE(...) int UNIQUE(p, __LINE__) = Tune::add(STRINGIFY((__VA_ARGS__)), __VA_ARGS__)
 
+#define TUNE_PACK(...) int UNIQUE(p, __LINE__) = Tune::add_pack(STRINGIFY((__VA_ARGS__)), __VA_ARGS__)
+
 #define UPDATE_ON_LAST() bool UNIQUE(p, __LINE__) = Tune::update_on_last = true
 
 }  // namespace Stockfish
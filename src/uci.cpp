@@ -19,23 +19,32 @@
 #include "uci.h"
 
 #include <algorithm>
+#include <memory>
 #include <cctype>
 #include <cmath>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <fstream>
+#include <iostream>
 #include <iterator>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "benchmark.h"
 #include "engine.h"
 #include "memory.h"
+#include "misc.h"
 #include "movegen.h"
 #include "position.h"
 #include "score.h"
 #include "search.h"
+#include "tune.h"
 #include "types.h"
 #include "ucioption.h"
 
@@ -52,13 +61,13 @@ struct overload: Ts... {
 template<typename... Ts>
 overload(Ts...) -> overload<Ts...>;
 
-void UCIEngine::print_info_string(std::string_view str) {
+void UCIEngine::print_info_string(std::string_view str, const std::string& prefix) {
     sync_cout_start();
     for (auto& line : split(str, "\n"))
     {
         if (!is_whitespace(line))
         {
-            std::cout << "info string " << line << '\n';
+            std::cout << prefix << "info string " << line << '\n';
         }
     }
     sync_cout_end();
@@ -85,16 +94,116 @@ void UCIEngine::init_search_update_listeners() {
     engine.set_on_verify_networks([](const auto& s) { print_info_string(s); });
 }
 
+void CommandQueue::push(std::string line) {
+
+    size_t t = tail.load(std::memory_order_relaxed);
+
+    // A full ring means the consumer is stuck in some long command; input
+    // arrives at GUI speed, so just yield until a slot frees up.
+    while (t - head.load(std::memory_order_acquire) == Capacity)
+        std::this_thread::yield();
+
+    ring[t & (Capacity - 1)] = std::move(line);
+    tail.store(t + 1, std::memory_order_seq_cst);
+
+    if (blocked.load(std::memory_order_seq_cst))
+    {
+        // Dummy lock/unlock so the consumer cannot miss the notify between
+        // its queue recheck and cv.wait()
+        { std::lock_guard<std::mutex> lk(mutex); }
+        cv.notify_one();
+    }
+}
+
+bool CommandQueue::pop(std::string& line) {
+
+    size_t h = head.load(std::memory_order_relaxed);
+
+    while (h == tail.load(std::memory_order_acquire))
+    {
+        if (closed.load(std::memory_order_acquire))
+            return false;
+
+        blocked.store(true, std::memory_order_seq_cst);
+
+        if (h == tail.load(std::memory_order_seq_cst)
+            && !closed.load(std::memory_order_seq_cst))
+        {
+            std::unique_lock<std::mutex> lk(mutex);
+            cv.wait(lk, [&] {
+                return h != tail.load(std::memory_order_acquire)
+                    || closed.load(std::memory_order_acquire);
+            });
+        }
+
+        blocked.store(false, std::memory_order_relaxed);
+    }
+
+    line = std::move(ring[h & (Capacity - 1)]);
+    head.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+void CommandQueue::close() {
+
+    closed.store(true, std::memory_order_seq_cst);
+
+    if (blocked.load(std::memory_order_seq_cst))
+    {
+        { std::lock_guard<std::mutex> lk(mutex); }
+        cv.notify_one();
+    }
+}
+
+bool UCIEngine::read_line(std::string& line) {
+
+    if (inputReader.joinable())
+        return commands.pop(line);
+
+    return bool(std::getline(std::cin, line));
+}
+
 void UCIEngine::loop() {
     std::string token, cmd;
 
     for (int i = 1; i < cli.argc; ++i)
         cmd += std::string(cli.argv[i]) + " ";
 
+    // In interactive sessions stdin is read by a dedicated thread, so the
+    // loop never blocks in getline() while commands are pending. 'stop' and
+    // 'quit' additionally take an atomic fast path: the reader raises
+    // threads.stop, which Search::Worker::check_time() already polls, the
+    // moment the line arrives, instead of waiting for the queue to drain.
+    // The queued copy still reaches the normal handler below, which is
+    // idempotent, so command ordering is unchanged.
+    if (cli.argc == 1)
+        inputReader = std::thread([this] {
+            std::string line;
+
+            while (std::getline(std::cin, line))
+            {
+                std::istringstream is(line);
+                std::string        tk;
+                is >> std::skipws >> tk;
+
+                if (tk == "stop" || tk == "quit")
+                    engine.stop();
+
+                commands.push(std::move(line));
+
+                // Exit before the final getline(): joining a thread that is
+                // blocked on a terminal read would hang the shutdown
+                if (tk == "quit")
+                    return;
+            }
+
+            commands.close();
+        });
+
     do
     {
         if (cli.argc == 1
-            && !getline(std::cin, cmd))  // Wait for an input or an end-of-file (EOF) indication
+            && !read_line(cmd))  // Wait for an input or an end-of-file (EOF) indication
             cmd = "quit";
 
         std::istringstream is(cmd);
@@ -103,7 +212,10 @@ void UCIEngine::loop() {
         is >> std::skipws >> token;
 
         if (token == "quit" || token == "stop")
+        {
             engine.stop();
+            stats_print();
+        }
 
         // The GUI sends 'ponderhit' to tell that the user has played the expected move.
         // So, 'ponderhit' is sent if pondering was done on the same move that the user
@@ -142,12 +254,109 @@ void UCIEngine::loop() {
             engine.flip();
         else if (token == "bench")
             bench(is);
+        else if (token == "perftbench")
+            perft_bench(is);
+        else if (token == "epdbench")
+            epd_bench(is);
+        else if (token == "seebench")
+        {
+            TimePoint elapsed = now();
+            auto [calls, hits] = Benchmark::see_bench();
+            elapsed = now() - elapsed + 1;  // Ensure positivity to avoid a 'divide by zero'
+
+            std::cerr << "\n==========================="    //
+                      << "\nTotal time (ms) : " << elapsed  //
+                      << "\nsee_ge() calls  : " << calls    //
+                      << "\nChecksum (hits) : " << hits     //
+                      << "\nCalls/second    : " << 1000 * calls / elapsed << std::endl;
+        }
         else if (token == BenchmarkCommand)
             benchmark(is);
         else if (token == "d")
             sync_cout << engine.visualize() << sync_endl;
         else if (token == "eval")
             engine.trace_eval();
+        else if (token == "evalbatch")
+            evalbatch(is);
+        else if (token == "wdlbatch")
+            wdlbatch(is);
+        else if (token == "analyze")
+            analyze(is);
+        else if (token == "multiuci")
+            multiuci(is);
+        else if (token == "tunematch")
+            tunematch(is);
+        // 'tt save [incremental] <file>' / 'tt load <file>': persist the hash
+        // table across sessions to warm-start repeated analysis
+        else if (token == "tt")
+        {
+            std::string subcmd, file;
+            is >> subcmd;
+
+            bool incremental = false;
+            if (is >> file && file == "incremental")
+            {
+                incremental = true;
+                is >> file;
+            }
+
+            bool ok = subcmd == "save"   ? engine.save_tt(file, incremental)
+                    : subcmd == "load"   ? engine.load_tt(file)
+                                         : false;
+
+            sync_cout << "info string tt " << subcmd << (ok ? " successful" : " failed")
+                      << sync_endl;
+        }
+        // 'checkpoint save [tt] <file>' / 'checkpoint load <file>': persist an
+        // interrupted analysis session ('stop' first) and resume it later; the
+        // next 'go' restarts iterative deepening at the saved depth
+        else if (token == "checkpoint")
+        {
+            std::string subcmd, file;
+            is >> subcmd;
+
+            bool withTT = false;
+            if (is >> file && file == "tt")
+            {
+                withTT = true;
+                is >> file;
+            }
+
+            bool ok = subcmd == "save"   ? engine.save_checkpoint(file, withTT)
+                    : subcmd == "load"   ? engine.load_checkpoint(file)
+                                         : false;
+
+            sync_cout << "info string checkpoint " << subcmd << (ok ? " successful" : " failed")
+                      << sync_endl;
+        }
+        // 'tracedump <file>': write the per-thread node traces collected with
+        // the 'Trace Nodes' option to disk, see nodetrace.h for the format
+        else if (token == "tracedump")
+        {
+            std::string file;
+            is >> file;
+
+            sync_cout << "info string tracedump "
+                      << (engine.dump_node_trace(file) ? "successful" : "failed") << sync_endl;
+        }
+        // 'parampack save <file>' / 'parampack load <file>': write the active
+        // search parameters as a binary pack, or swap in a new set, see tune.h
+        else if (token == "parampack")
+        {
+            std::string subcmd, file;
+            is >> subcmd >> file;
+
+            bool ok = subcmd == "save" ? Tune::save_pack(file)
+                    : subcmd == "load" ? Tune::load_pack(file)
+                                       : false;
+
+            sync_cout << "info string parampack " << subcmd << (ok ? " successful" : " failed")
+                      << sync_endl;
+        }
+        // 'latencystats': dump and reset the histograms recorded with the
+        // 'Latency Stats' option, see misc.h for the metrics
+        else if (token == "latencystats")
+            sync_cout << latency_report() << sync_endl;
         else if (token == "compiler")
             sync_cout << compiler_info() << sync_endl;
         else if (token == "export_net")
@@ -162,6 +371,19 @@ void UCIEngine::loop() {
 
             engine.save_network(files);
         }
+        // Converts the loaded networks into raw parameter dumps for fast startup
+        else if (token == "export_net_raw")
+        {
+            std::pair<std::optional<std::string>, std::string> files[2];
+
+            if (is >> std::skipws >> files[0].second)
+                files[0].first = files[0].second;
+
+            if (is >> std::skipws >> files[1].second)
+                files[1].first = files[1].second;
+
+            engine.save_network_raw(files);
+        }
         else if (token == "--help" || token == "help" || token == "--license" || token == "license")
             sync_cout
               << "\nStockfish is a powerful chess engine for playing and analyzing."
@@ -176,6 +398,9 @@ void UCIEngine::loop() {
                       << sync_endl;
 
     } while (token != "quit" && cli.argc == 1);  // The command-line arguments are one-shot
+
+    if (inputReader.joinable())
+        inputReader.join();
 }
 
 Search::LimitsType UCIEngine::parse_limits(std::istream& is) {
@@ -213,6 +438,11 @@ Search::LimitsType UCIEngine::parse_limits(std::istream& is) {
             limits.infinite = 1;
         else if (token == "ponder")
             limits.ponderMode = true;
+        // Pin evaluation to the small network for this search, trading some
+        // eval quality for roughly half the per-node eval cost; meant for
+        // high-volume shallow screening searches
+        else if (token == "smallnet")
+            limits.smallNet = true;
 
     return limits;
 }
@@ -227,6 +457,552 @@ void UCIEngine::go(std::istringstream& is) {
         engine.go(limits);
 }
 
+// Reads FEN strings one per line, either from the file given as argument or from
+// standard input until a line reading "end" (or EOF), and prints one static
+// evaluation in centipawns per line, in input order. Positions where the side to
+// move is in check print "none". Input is processed in chunks so arbitrarily long
+// pipelines run in constant memory.
+void UCIEngine::evalbatch(std::istringstream& is) {
+    std::string source;
+    is >> std::ws;
+    std::getline(is, source);
+
+    std::ifstream file;
+    if (!source.empty())
+    {
+        file.open(source);
+        if (!file)
+        {
+            sync_cout << "info string Unable to open file " << source << sync_endl;
+            return;
+        }
+    }
+
+    // Stdin lines come through read_line(), which respects the input reader
+    // thread of loop()
+    auto next = [&](std::string& line) {
+        return source.empty() ? read_line(line) : bool(std::getline(file, line));
+    };
+
+    constexpr size_t ChunkSize = 512;
+
+    std::vector<std::string> fens;
+    std::string              line;
+    bool                     done = false;
+
+    while (!done)
+    {
+        fens.clear();
+        while (fens.size() < ChunkSize && next(line) && line != "end")
+            if (!is_whitespace(line))
+                fens.push_back(line);
+
+        done = fens.size() < ChunkSize;
+
+        for (int cp : engine.evaluate_batch(fens))
+            sync_cout << (cp == VALUE_NONE ? std::string("none") : std::to_string(cp))
+                      << sync_endl;
+    }
+}
+
+// Reads "<eval> <material>" pairs one per line, either from the file given as
+// argument or from standard input until a line reading "end" (or EOF), and
+// prints one "w d l" triple in per mille units per line, in input order. Evals
+// are in internal units, material is the model's weighted piece count. Backs
+// the rescoring pipeline, which converts millions of stored evals at once.
+void UCIEngine::wdlbatch(std::istringstream& is) {
+    std::string source;
+    is >> std::ws;
+    std::getline(is, source);
+
+    std::ifstream file;
+    if (!source.empty())
+    {
+        file.open(source);
+        if (!file)
+        {
+            sync_cout << "info string Unable to open file " << source << sync_endl;
+            return;
+        }
+    }
+
+    auto next = [&](std::string& line) {
+        return source.empty() ? read_line(line) : bool(std::getline(file, line));
+    };
+
+    constexpr size_t ChunkSize = 4096;
+
+    std::vector<Value>              evals;
+    std::vector<int>                materials;
+    std::vector<WDLModel::WDLTriple> wdls;
+    std::string                     line;
+    bool                            done = false;
+
+    while (!done)
+    {
+        evals.clear();
+        materials.clear();
+        while (evals.size() < ChunkSize && next(line) && line != "end")
+        {
+            if (is_whitespace(line))
+                continue;
+
+            std::istringstream pair(line);
+            int                eval, material;
+            if (pair >> eval >> material)
+            {
+                evals.push_back(Value(eval));
+                materials.push_back(material);
+            }
+        }
+
+        done = evals.size() < ChunkSize;
+
+        wdls.resize(evals.size());
+        WDLModel::wdl_batch(evals.data(), materials.data(), wdls.data(), evals.size());
+
+        for (const auto& [w, d, l] : wdls)
+            sync_cout << w << " " << d << " " << l << sync_endl;
+    }
+}
+
+// 'analyze [depth <d>] [file <name>]': batch analysis of a FEN stream, from a
+// file or from stdin until "end" or EOF. A producer thread reads and filters
+// the input into a bounded queue while the pool searches the previous
+// position, and the pv/bestmove output of position i overlaps the setup of
+// position i+1, so the per-position UCI round-trip is off the critical path.
+void UCIEngine::analyze(std::istringstream& is) {
+    std::string token, source;
+    int         depth = 12;
+
+    while (is >> token)
+    {
+        if (token == "depth")
+            is >> depth;
+        else if (token == "file")
+            is >> source;
+    }
+
+    // Files go through the memory-mapped EPD reader shared with 'epdbench',
+    // so plain FEN files and EPD files with opcodes are both accepted
+    std::vector<std::string> corpus;
+    if (!source.empty())
+    {
+        corpus = Benchmark::read_epd_corpus(source);
+        if (corpus.empty())
+        {
+            sync_cout << "info string No positions in file " << source << sync_endl;
+            return;
+        }
+    }
+
+    // Stdin lines come through read_line(), which respects the input reader
+    // thread of loop(); it is only ever called from the producer below, so
+    // the command queue keeps a single consumer.
+    size_t corpusPos = 0;
+    auto   next      = [&](std::string& line) {
+        if (source.empty())
+            return read_line(line);
+        if (corpusPos >= corpus.size())
+            return false;
+        line = corpus[corpusPos++];
+        return true;
+    };
+
+    constexpr size_t MaxQueued = 256;
+
+    std::mutex              mutex;
+    std::condition_variable notFull, notEmpty;
+    std::deque<std::string> queue;
+    bool                    inputDone = false;
+
+    std::thread producer([&] {
+        std::string line;
+        while (next(line) && line != "end")
+        {
+            if (is_whitespace(line))
+                continue;
+
+            std::unique_lock<std::mutex> lk(mutex);
+            notFull.wait(lk, [&] { return queue.size() < MaxQueued; });
+            queue.push_back(std::move(line));
+            notEmpty.notify_one();
+        }
+
+        std::lock_guard<std::mutex> lk(mutex);
+        inputDone = true;
+        notEmpty.notify_one();
+    });
+
+    Search::LimitsType limits;
+    limits.depth = depth;
+
+    uint64_t cnt = 0;
+    while (true)
+    {
+        std::string fen;
+        {
+            std::unique_lock<std::mutex> lk(mutex);
+            notEmpty.wait(lk, [&] { return !queue.empty() || inputDone; });
+            if (queue.empty())
+                break;
+            fen = std::move(queue.front());
+            queue.pop_front();
+            notFull.notify_one();
+        }
+
+        // The previous search may still be printing its last pvs; joining here
+        // still lets its output overlap this position's queue pop and parse.
+        engine.wait_for_search_finished();
+
+        sync_cout << "info string analyzing " << fen << sync_endl;
+        engine.set_position(fen, {});
+
+        limits.startTime = now();
+        engine.go(limits);
+        ++cnt;
+    }
+
+    engine.wait_for_search_finished();
+    producer.join();
+
+    sync_cout << "info string analyze done, positions " << cnt << sync_endl;
+}
+
+
+// 'multiuci <N>': serve N independent engine sessions over one multiplexed
+// UCI stream, for match harnesses that run several games per host in a
+// single process. Every input line starts with a session id in [0, N) and
+// every output line is prefixed with the id of the session it belongs to.
+// Session 0 is this process's own engine; the additional sessions share its
+// replicated networks (and the global bitboard tables) read-only, so memory
+// does not scale with the session count, while TT, threads and options stay
+// private per session. Sessions search concurrently; dividing cores between
+// them is left to each session's Threads option and the OS scheduler. A
+// 'quit' leaves the mode and returns to the plain UCI loop.
+void UCIEngine::multiuci(std::istringstream& is) {
+    int n = 2;
+    is >> n;
+    n = std::clamp(n, 1, 64);
+
+    std::vector<std::unique_ptr<Engine>> secondaries;
+    for (int i = 1; i < n; ++i)
+        secondaries.push_back(std::make_unique<Engine>(std::nullopt, &engine.shared_networks()));
+
+    auto session = [&](size_t id) -> Engine& { return id == 0 ? engine : *secondaries[id - 1]; };
+
+    for (size_t id = 0; id < size_t(n); ++id)
+    {
+        Engine&           e   = session(id);
+        const std::string pre = std::to_string(id) + " ";
+
+        e.set_on_iter([pre](const auto& i) { on_iter(i, pre); });
+        e.set_on_update_no_moves([pre](const auto& i) { on_update_no_moves(i, pre); });
+        e.set_on_update_full(
+          [pre, &e](const auto& i) { on_update_full(i, e.get_options()["UCI_ShowWDL"], pre); });
+        e.set_on_bestmove([pre](const auto& bm, const auto& p) { on_bestmove(bm, p, pre); });
+        e.set_on_verify_networks([pre](const auto& str) { print_info_string(str, pre); });
+    }
+
+    sync_cout << "info string multiuci serving " << n << " sessions" << sync_endl;
+
+    std::string line;
+    bool        quitAll = false;
+    while (read_line(line))
+    {
+        std::istringstream ls(line);
+        std::string        token;
+        size_t             id = 0;
+
+        if (!(ls >> id))
+        {
+            // A bare 'quit' must still shut the mode down
+            ls.clear();
+            ls.seekg(0);
+            ls >> token;
+            if (token == "quit")
+            {
+                quitAll = true;
+                break;
+            }
+            if (!token.empty())
+                sync_cout << "info string multiuci expects '<session> <command>': " << line
+                          << sync_endl;
+            continue;
+        }
+
+        if (id >= size_t(n))
+        {
+            sync_cout << "info string no such session " << id << sync_endl;
+            continue;
+        }
+
+        Engine&           e   = session(id);
+        const std::string pre = std::to_string(id) + " ";
+
+        token.clear();
+        ls >> token;
+
+        if (token == "quit")
+            break;
+        else if (token == "stop")
+            e.stop();
+        else if (token == "ponderhit")
+            e.set_ponderhit(false);
+        else if (token == "uci")
+        {
+            sync_cout_start();
+            const std::string idStr = "id name " + engine_info(true);
+            for (auto& idLine : split(idStr, "\n"))
+                std::cout << pre << idLine << '\n';
+            std::ostringstream opts;
+            opts << e.get_options();
+            const std::string optionsStr = opts.str();
+            for (auto& optionLine : split(optionsStr, "\n"))
+                if (!is_whitespace(optionLine))
+                    std::cout << pre << optionLine << '\n';
+            std::cout << pre << "uciok" << '\n';
+            sync_cout_end();
+        }
+        else if (token == "setoption")
+        {
+            e.wait_for_search_finished();
+            e.get_options().setoption(ls);
+        }
+        else if (token == "position")
+            parse_position(e, ls);
+        else if (token == "ucinewgame")
+            e.search_clear();
+        else if (token == "isready")
+            sync_cout << pre << "readyok" << sync_endl;
+        else if (token == "go")
+        {
+            Search::LimitsType limits = parse_limits(ls);
+            if (!limits.perft)
+                e.go(limits);
+        }
+        else if (!token.empty())
+            sync_cout << pre << "info string unknown command in multiuci mode: " << token
+                      << sync_endl;
+    }
+
+    // Let every session finish before the secondaries are destroyed, then
+    // hand session 0 back to the plain loop with unprefixed output
+    for (size_t id = 0; id < size_t(n); ++id)
+    {
+        session(id).stop();
+        session(id).wait_for_search_finished();
+    }
+    init_search_update_listeners();
+
+    // A bare 'quit' already made the input reader exit, so the outer loop
+    // would block on an empty queue; feed the 'quit' back for it to act on
+    if (quitAll && inputReader.joinable())
+        commands.push("quit");
+}
+
+
+// 'tunematch <games> <base[+inc]> [packA [packB]]': play an in-process
+// self-play match between two tuned-parameter sets, skipping the process
+// spawning and UCI plumbing of an external match runner. The sets come from
+// parameter-pack files (see Tune::load_pack); a missing file name means the
+// currently active values. Games are played in pairs on a shared random
+// opening with colors swapped and reported as pentanomial pair outcomes.
+// The tuned variables are process globals, so the two sets cannot live in
+// the two engines at once; instead the set of the side to move is swapped
+// in before each search. Searches alternate within a game, so the engines
+// share the machine timeslice-wise and never run concurrently.
+void UCIEngine::tunematch(std::istringstream& is) {
+
+    int         games = 0;
+    std::string tc, packA, packB;
+    is >> games >> tc >> packA >> packB;
+
+    double baseSec = 0, incSec = 0;
+    {
+        std::istringstream ts(tc);
+        char               plus;
+        ts >> baseSec;
+        if (ts >> plus && plus == '+')
+            ts >> incSec;
+    }
+
+    if (games <= 0 || baseSec <= 0)
+    {
+        sync_cout << "info string usage: tunematch <games> <base[+inc]> [packA [packB]]"
+                  << sync_endl;
+        return;
+    }
+
+    engine.wait_for_search_finished();
+
+    const std::vector<int> baseline = Tune::snapshot_pack();
+
+    auto load_set = [&](const std::string& file) -> std::optional<std::vector<int>> {
+        if (file.empty())
+            return baseline;
+        if (!Tune::load_pack(file))
+            return std::nullopt;
+        std::vector<int> set = Tune::snapshot_pack();
+        Tune::apply_snapshot(baseline);
+        return set;
+    };
+
+    const auto setA = load_set(packA), setB = load_set(packB);
+    if (!setA || !setB)
+    {
+        Tune::apply_snapshot(baseline);
+        sync_cout << "info string tunematch failed to load pack '" << (!setA ? packA : packB)
+                  << "'" << sync_endl;
+        return;
+    }
+
+    // The challenger borrows the primary engine's networks and mirrors its
+    // thread and hash resources, so both sides search under equal conditions
+    Engine second(std::nullopt, &engine.shared_networks());
+    second.get_options()["Threads"] = std::to_string(int(engine.get_options()["Threads"]));
+    second.get_options()["Hash"]    = std::to_string(int(engine.get_options()["Hash"]));
+
+    Engine*                 engines[2] = {&engine, &second};
+    const std::vector<int>* sets[2]    = {&*setA, &*setB};
+
+    std::string best;
+    for (auto* e : engines)
+    {
+        e->set_on_update_no_moves([](const auto&) {});
+        e->set_on_update_full([](const auto&) {});
+        e->set_on_iter([](const auto&) {});
+        e->set_on_bestmove([&best](std::string_view bm, std::string_view) { best = bm; });
+    }
+
+    const int pairs    = (games + 1) / 2;
+    int       penta[5] = {};
+    PRNG      rng(0x7565ULL);  // Fixed seed: reruns replay the same openings
+
+    for (int pair = 0; pair < pairs; ++pair)
+    {
+        // A short random opening shared by both games of the pair
+        std::vector<std::string> opening;
+        {
+            Position     pos;
+            StateListPtr sts(new std::deque<StateInfo>(1));
+            pos.set(StartFEN, false, &sts->back());
+
+            for (int ply = 0; ply < 8; ++ply)
+            {
+                MoveList<LEGAL> ml(pos);
+                if (!ml.size())
+                    break;
+
+                Move m = *(ml.begin() + rng.rand<std::uint64_t>() % ml.size());
+                opening.push_back(move(m, false));
+                sts->emplace_back();
+                pos.do_move(m, sts->back());
+            }
+        }
+
+        int pairPoints = 0;  // Points scored by set A over the pair, 0..4
+
+        for (int g = 0; g < 2; ++g)  // Game 1: A is White, game 2: A is Black
+        {
+            std::vector<std::string> moves = opening;
+
+            Position     pos;
+            StateListPtr sts(new std::deque<StateInfo>(1));
+            pos.set(StartFEN, false, &sts->back());
+            for (const auto& m : moves)
+            {
+                sts->emplace_back();
+                pos.do_move(to_move(pos, m), sts->back());
+            }
+
+            for (auto* e : engines)
+                e->search_clear();
+
+            double clock[COLOR_NB] = {baseSec * 1000, baseSec * 1000};
+            int    result;  // 2: A wins, 1: draw, 0: A loses
+
+            while (true)
+            {
+                if (!has_legal_moves(pos))
+                {
+                    const int mated = (g == 0) == (pos.side_to_move() == WHITE) ? 0 : 2;
+                    result          = pos.checkers() ? mated : 1;
+                    break;
+                }
+
+                // is_draw(0): only a true threefold or the 50-move rule count
+                if (pos.is_draw(0) || moves.size() >= opening.size() + 400)
+                {
+                    result = 1;
+                    break;
+                }
+
+                const Color stm = pos.side_to_move();
+                const int   idx = (g == 0) == (stm == WHITE) ? 0 : 1;
+                Engine&     e   = *engines[idx];
+
+                Tune::apply_snapshot(*sets[idx]);
+
+                Search::LimitsType limits;
+                limits.startTime   = now();
+                limits.time[WHITE] = std::max<TimePoint>(1, TimePoint(clock[WHITE]));
+                limits.time[BLACK] = std::max<TimePoint>(1, TimePoint(clock[BLACK]));
+                limits.inc[WHITE] = limits.inc[BLACK] = TimePoint(incSec * 1000);
+
+                best.clear();
+                e.set_position(StartFEN, moves);
+
+                const TimePoint t0 = now();
+                e.go(limits);
+                e.wait_for_search_finished();
+                clock[stm] -= double(now() - t0);
+
+                if (clock[stm] < 0)  // Flag fall loses, as it would on the cluster
+                {
+                    result = idx == 0 ? 0 : 2;
+                    break;
+                }
+                clock[stm] += incSec * 1000;
+
+                Move m = best.empty() ? Move::none() : to_move(pos, best);
+                if (!m)
+                {
+                    result = idx == 0 ? 0 : 2;
+                    break;
+                }
+
+                moves.push_back(best);
+                sts->emplace_back();
+                pos.do_move(m, sts->back());
+            }
+
+            pairPoints += result;
+        }
+
+        penta[pairPoints]++;
+
+        sync_cout << "info string tunematch pair " << pair + 1 << "/" << pairs << " pentanomial ["
+                  << penta[0] << ", " << penta[1] << ", " << penta[2] << ", " << penta[3] << ", "
+                  << penta[4] << "]" << sync_endl;
+    }
+
+    double points = 0;
+    for (int i = 0; i < 5; ++i)
+        points += i * penta[i];
+    const double score = points / (4.0 * pairs);
+
+    std::ostringstream res;
+    res << "tunematch result pentanomial [" << penta[0] << ", " << penta[1] << ", " << penta[2]
+        << ", " << penta[3] << ", " << penta[4] << "] score " << 100 * score << "%";
+    if (score > 0 && score < 1)
+        res << " elo " << -400 * std::log10(1 / score - 1);
+    sync_cout << res.str() << sync_endl;
+
+    Tune::apply_snapshot(baseline);
+    init_search_update_listeners();
+}
+
 void UCIEngine::bench(std::istream& args) {
     std::string token;
     uint64_t    num, nodes = 0, cnt = 1;
@@ -245,6 +1021,8 @@ void UCIEngine::bench(std::istream& args) {
 
     TimePoint elapsed = now();
 
+    const auto [pawnProbes0, pawnHits0] = engine.pawn_cache_stats();
+
     for (const auto& cmd : list)
     {
         std::istringstream is(cmd);
@@ -287,15 +1065,163 @@ void UCIEngine::bench(std::istream& args) {
 
     dbg_print();
 
+    const auto [pawnProbes1, pawnHits1] = engine.pawn_cache_stats();
+    const uint64_t pawnProbes           = pawnProbes1 - pawnProbes0;
+    const uint64_t pawnHits             = pawnHits1 - pawnHits0;
+
     std::cerr << "\n==========================="    //
               << "\nTotal time (ms) : " << elapsed  //
               << "\nNodes searched  : " << nodes    //
-              << "\nNodes/second    : " << 1000 * nodes / elapsed << std::endl;
+              << "\nNodes/second    : " << 1000 * nodes / elapsed  //
+              << "\nPawn cache      : " << pawnHits << '/' << pawnProbes << " hits ("
+              << 100.0 * double(pawnHits) / double(std::max<uint64_t>(pawnProbes, 1)) << "%)"
+              << std::endl;
 
     // reset callback, to not capture a dangling reference to nodesSearched
     engine.set_on_update_full([&](const auto& i) { on_update_full(i, options["UCI_ShowWDL"]); });
 }
 
+void UCIEngine::perft_bench(std::istream& args) {
+    std::string token;
+    uint64_t    num, nodes = 0, cnt = 1;
+
+    std::vector<std::string> list = Benchmark::setup_perft_bench(engine.fen(), args);
+
+    num = count_if(list.begin(), list.end(),
+                   [](const std::string& s) { return s.find("go ") == 0; });
+
+    TimePoint elapsed = now();
+
+    for (const auto& cmd : list)
+    {
+        std::istringstream is(cmd);
+        is >> std::skipws >> token;
+
+        if (token == "go")
+        {
+            std::cerr << "\nPosition: " << cnt++ << '/' << num << " (" << engine.fen() << ")"
+                      << std::endl;
+
+            Search::LimitsType limits = parse_limits(is);
+            nodes += perft(limits);
+        }
+        else if (token == "setoption")
+            setoption(is);
+        else if (token == "position")
+            position(is);
+    }
+
+    elapsed = now() - elapsed + 1;  // Ensure positivity to avoid a 'divide by zero'
+
+    std::cerr << "\n==========================="    //
+              << "\nTotal time (ms) : " << elapsed  //
+              << "\nNodes searched  : " << nodes    //
+              << "\nNodes/second    : " << 1000 * nodes / elapsed << std::endl;
+}
+
+// Runs a fixed-depth search over an external EPD/FEN corpus and reports nps
+// per game phase, p50/p99 time-to-depth, and a nodes signature per shard so
+// release runs can be compared record-for-record. Each search still spreads
+// over all configured threads; the shards only partition the corpus.
+// Usage: epdbench <file> [depth] [shards]
+void UCIEngine::epd_bench(std::istream& args) {
+
+    std::string file;
+    int         depth, shards;
+
+    args >> file;
+    if (!(args >> depth))
+        depth = 12;
+    if (!(args >> shards))
+        shards = 4;
+
+    if (file.empty())
+    {
+        std::cerr << "epdbench: missing corpus file" << std::endl;
+        return;
+    }
+
+    const std::vector<std::string> fens = Benchmark::read_epd_corpus(file);
+    if (fens.empty())
+    {
+        std::cerr << "epdbench: no positions in " << file << std::endl;
+        return;
+    }
+
+    depth  = std::max(depth, 1);
+    shards = std::clamp(shards, 1, 64);
+
+    uint64_t nodesSearched = 0;
+    engine.set_on_update_full([&](const Engine::InfoFull& i) { nodesSearched = i.nodes; });
+    engine.set_on_iter([](const auto&) {});
+    engine.set_on_update_no_moves([](const auto&) {});
+    engine.set_on_bestmove([](const auto&, const auto&) {});
+
+    struct PhaseStats {
+        std::vector<TimePoint> ttd;
+        uint64_t               nodes = 0;
+        TimePoint              time  = 0;
+    };
+    static constexpr std::string_view PhaseNames[3] = {"opening", "middlegame", "endgame"};
+
+    std::array<PhaseStats, 3> phaseStats;
+    std::vector<uint64_t>     shardSignature(shards, 0);
+
+    Search::LimitsType limits;
+    limits.depth = depth;
+
+    for (size_t idx = 0; idx < fens.size(); ++idx)
+    {
+        const std::string& fen = fens[idx];
+
+        // Classify the phase from the board field's non-pawn piece count
+        int pieces = 0;
+        for (char c : fen.substr(0, fen.find(' ')))
+            pieces += std::string_view("NBRQnbrq").find(c) != std::string_view::npos;
+        const int phase = pieces >= 10 ? 0 : pieces >= 5 ? 1 : 2;
+
+        engine.set_position(fen, {});
+
+        nodesSearched = 0;
+        TimePoint t0  = now();
+        engine.go(limits);
+        engine.wait_for_search_finished();
+        TimePoint ttd = now() - t0 + 1;
+
+        auto& ps = phaseStats[phase];
+        ps.ttd.push_back(ttd);
+        ps.nodes += nodesSearched;
+        ps.time += ttd;
+        shardSignature[idx % shards] += nodesSearched;
+    }
+
+    const auto& options = engine.get_options();
+    engine.set_on_update_full([&](const auto& i) { on_update_full(i, options["UCI_ShowWDL"]); });
+
+    auto percentile = [](std::vector<TimePoint>& v, double p) {
+        std::sort(v.begin(), v.end());
+        return v[size_t(p * double(v.size() - 1))];
+    };
+
+    std::cerr << "\n===========================" << "\nPositions       : " << fens.size()
+              << "  depth " << depth << std::endl;
+
+    for (size_t ph = 0; ph < 3; ++ph)
+    {
+        auto& ps = phaseStats[ph];
+        if (ps.ttd.empty())
+            continue;
+
+        std::cerr << PhaseNames[ph] << " : " << ps.ttd.size() << " positions"  //
+                  << ", nps " << 1000 * ps.nodes / uint64_t(ps.time)           //
+                  << ", ttd p50 (ms) " << percentile(ps.ttd, 0.50)             //
+                  << ", p99 (ms) " << percentile(ps.ttd, 0.99) << std::endl;
+    }
+
+    for (int s = 0; s < shards; ++s)
+        std::cerr << "shard " << s << " signature : " << shardSignature[s] << std::endl;
+}
+
 void UCIEngine::benchmark(std::istream& args) {
     // Probably not very important for a test this long, but include for completeness and sanity.
     static constexpr int NUM_WARMUP_POSITIONS = 3;
@@ -471,7 +1397,9 @@ std::uint64_t UCIEngine::perft(const Search::LimitsType& limits) {
     return nodes;
 }
 
-void UCIEngine::position(std::istringstream& is) {
+void UCIEngine::position(std::istringstream& is) { parse_position(engine, is); }
+
+void UCIEngine::parse_position(Engine& e, std::istringstream& is) {
     std::string token, fen;
 
     is >> token;
@@ -494,43 +1422,7 @@ void UCIEngine::position(std::istringstream& is) {
         moves.push_back(token);
     }
 
-    engine.set_position(fen, moves);
-}
-
-namespace {
-
-struct WinRateParams {
-    double a;
-    double b;
-};
-
-WinRateParams win_rate_params(const Position& pos) {
-
-    int material = pos.count<PAWN>() + 3 * pos.count<KNIGHT>() + 3 * pos.count<BISHOP>()
-                 + 5 * pos.count<ROOK>() + 9 * pos.count<QUEEN>();
-
-    // The fitted model only uses data for material counts in [17, 78], and is anchored at count 58.
-    double m = std::clamp(material, 17, 78) / 58.0;
-
-    // Return a = p_a(material) and b = p_b(material), see github.com/official-stockfish/WDL_model
-    constexpr double as[] = {-37.45051876, 121.19101539, -132.78783573, 420.70576692};
-    constexpr double bs[] = {90.26261072, -137.26549898, 71.10130540, 51.35259597};
-
-    double a = (((as[0] * m + as[1]) * m + as[2]) * m) + as[3];
-    double b = (((bs[0] * m + bs[1]) * m + bs[2]) * m) + bs[3];
-
-    return {a, b};
-}
-
-// The win rate model is 1 / (1 + exp((a - eval) / b)), where a = p_a(material) and b = p_b(material).
-// It fits the LTC fishtest statistics rather accurately.
-int win_rate_model(Value v, const Position& pos) {
-
-    auto [a, b] = win_rate_params(pos);
-
-    // Return the win rate in per mille units, rounded to the nearest integer.
-    return int(0.5 + 1000 / (1 + std::exp((a - double(v)) / b)));
-}
+    e.set_position(fen, moves);
 }
 
 std::string UCIEngine::format_score(const Score& s) {
@@ -557,9 +1449,9 @@ int UCIEngine::to_cp(Value v, const Position& pos) {
 
     // In general, the score can be defined via the WDL as
     // (log(1/L - 1) - log(1/W - 1)) / (log(1/L - 1) + log(1/W - 1)).
-    // Based on our win_rate_model, this simply yields v / a.
+    // Based on our win rate model, this simply yields v / a.
 
-    auto [a, b] = win_rate_params(pos);
+    auto [a, b] = WDLModel::win_rate_params(WDLModel::material_count(pos));
 
     return std::round(100 * int(v) / a);
 }
@@ -567,9 +1459,10 @@ int UCIEngine::to_cp(Value v, const Position& pos) {
 std::string UCIEngine::wdl(Value v, const Position& pos) {
     std::stringstream ss;
 
-    int wdl_w = win_rate_model(v, pos);
-    int wdl_l = win_rate_model(-v, pos);
-    int wdl_d = 1000 - wdl_w - wdl_l;
+    int material = WDLModel::material_count(pos);
+    int wdl_w    = WDLModel::win_rate(v, material);
+    int wdl_l    = WDLModel::win_rate(-v, material);
+    int wdl_d    = 1000 - wdl_w - wdl_l;
     ss << wdl_w << " " << wdl_d << " " << wdl_l;
 
     return ss.str();
@@ -617,14 +1510,17 @@ Move UCIEngine::to_move(const Position& pos, std::string str) {
     return Move::none();
 }
 
-void UCIEngine::on_update_no_moves(const Engine::InfoShort& info) {
-    sync_cout << "info depth " << info.depth << " score " << format_score(info.score) << sync_endl;
+void UCIEngine::on_update_no_moves(const Engine::InfoShort& info, const std::string& prefix) {
+    sync_cout << prefix << "info depth " << info.depth << " score " << format_score(info.score)
+              << sync_endl;
 }
 
-void UCIEngine::on_update_full(const Engine::InfoFull& info, bool showWDL) {
+void UCIEngine::on_update_full(const Engine::InfoFull& info,
+                               bool                    showWDL,
+                               const std::string&      prefix) {
     std::stringstream ss;
 
-    ss << "info";
+    ss << prefix << "info";
     ss << " depth " << info.depth                 //
        << " seldepth " << info.selDepth           //
        << " multipv " << info.multiPV             //
@@ -646,10 +1542,10 @@ void UCIEngine::on_update_full(const Engine::InfoFull& info, bool showWDL) {
     sync_cout << ss.str() << sync_endl;
 }
 
-void UCIEngine::on_iter(const Engine::InfoIter& info) {
+void UCIEngine::on_iter(const Engine::InfoIter& info, const std::string& prefix) {
     std::stringstream ss;
 
-    ss << "info";
+    ss << prefix << "info";
     ss << " depth " << info.depth                     //
        << " currmove " << info.currmove               //
        << " currmovenumber " << info.currmovenumber;  //
@@ -657,8 +1553,10 @@ void UCIEngine::on_iter(const Engine::InfoIter& info) {
     sync_cout << ss.str() << sync_endl;
 }
 
-void UCIEngine::on_bestmove(std::string_view bestmove, std::string_view ponder) {
-    sync_cout << "bestmove " << bestmove;
+void UCIEngine::on_bestmove(std::string_view    bestmove,
+                            std::string_view    ponder,
+                            const std::string&  prefix) {
+    sync_cout << prefix << "bestmove " << bestmove;
     if (!ponder.empty())
         std::cout << " ponder " << ponder;
     std::cout << sync_endl;
@@ -19,10 +19,16 @@
 #ifndef UCI_H_INCLUDED
 #define UCI_H_INCLUDED
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <string_view>
+#include <thread>
 
 #include "engine.h"
 #include "misc.h"
@@ -36,6 +42,39 @@ class Score;
 enum Square : int;
 using Value = int;
 
+// Single-producer single-consumer queue of input lines between the stdin
+// reader thread and the UCI loop. The data path is a lock-free ring with
+// atomic head/tail indices; the mutex and condition variable only implement
+// the sleep/wake doorbell for an empty queue, following the same
+// spin-then-block protocol as the search threads in thread.cpp.
+class CommandQueue {
+   public:
+    // Enqueues a line, spinning if the consumer is more than Capacity
+    // commands behind. Producer side only.
+    void push(std::string line);
+
+    // Dequeues the oldest line, blocking while the queue is empty. Returns
+    // false once the queue is closed and drained. Consumer side only.
+    bool pop(std::string& line);
+
+    // Marks the end of input (EOF on stdin); pop() keeps succeeding until
+    // the queue is drained.
+    void close();
+
+   private:
+    static constexpr size_t Capacity = 128;  // Power of two
+
+    std::array<std::string, Capacity> ring;
+
+    alignas(64) std::atomic<size_t> head{0};  // Next slot to pop
+    alignas(64) std::atomic<size_t> tail{0};  // Next slot to push
+
+    std::atomic<bool>       closed{false};
+    std::atomic<bool>       blocked{false};  // Consumer is (about to be) in cv.wait()
+    std::mutex              mutex;
+    std::condition_variable cv;
+};
+
 class UCIEngine {
    public:
     UCIEngine(int argc, char** argv);
@@ -58,19 +97,38 @@ class UCIEngine {
     Engine      engine;
     CommandLine cli;
 
-    static void print_info_string(std::string_view str);
+    // Interactive input arrives through a dedicated reader thread, see loop()
+    CommandQueue commands;
+    std::thread  inputReader;
+
+    static void print_info_string(std::string_view str, const std::string& prefix = {});
+
+    // Next line of stdin: from the command queue when the reader thread is
+    // running, directly from std::cin otherwise. False on end of input.
+    bool read_line(std::string& line);
 
     void          go(std::istringstream& is);
+    void          multiuci(std::istringstream& is);
+    void          tunematch(std::istringstream& is);
+    void          evalbatch(std::istringstream& is);
+    void          wdlbatch(std::istringstream& is);
+    void          analyze(std::istringstream& is);
     void          bench(std::istream& args);
+    void          epd_bench(std::istream& args);
+    void          perft_bench(std::istream& args);
     void          benchmark(std::istream& args);
     void          position(std::istringstream& is);
+    static void   parse_position(Engine& e, std::istringstream& is);
     void          setoption(std::istringstream& is);
     std::uint64_t perft(const Search::LimitsType&);
 
-    static void on_update_no_moves(const Engine::InfoShort& info);
-    static void on_update_full(const Engine::InfoFull& info, bool showWDL);
-    static void on_iter(const Engine::InfoIter& info);
-    static void on_bestmove(std::string_view bestmove, std::string_view ponder);
+    static void on_update_no_moves(const Engine::InfoShort& info, const std::string& prefix = {});
+    static void
+    on_update_full(const Engine::InfoFull& info, bool showWDL, const std::string& prefix = {});
+    static void on_iter(const Engine::InfoIter& info, const std::string& prefix = {});
+    static void on_bestmove(std::string_view   bestmove,
+                            std::string_view   ponder,
+                            const std::string& prefix = {});
 
     void init_search_update_listeners();
 };
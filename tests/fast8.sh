@@ -0,0 +1,85 @@
+#!/bin/bash
+# compare the fast8 (int8 NNUE weight storage) build against the reference
+# build: fixed-depth scores over a set of positions, reporting the score
+# correlation and the mean absolute deviation. Fails when the correlation
+# drops below 0.99, which empirically corresponds to a measurable Elo loss.
+#
+# usage: fast8.sh [ARCH] [depth]
+
+error()
+{
+  echo "fast8 testing failed on line $1"
+  exit 1
+}
+trap 'error ${LINENO}' ERR
+
+ARCH=${1:-x86-64-avx2}
+depth=${2:-10}
+
+echo "fast8 testing started, ARCH=$ARCH depth=$depth"
+
+cat << EOF > fast8_positions.txt
+rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1
+r1bq1rk1/pp2ppbp/2np1np1/8/3NP3/2N1BP2/PPPQ2PP/R3KB1R w KQ - 3 9
+r3kb1r/3n1pp1/p6p/2pPp2q/Pp2N3/3B2PP/1PQ2P2/R3K2R w KQkq - 0 19
+rn1q1rk1/1b2bppp/1pn1p3/p2pP3/3P4/P1NB1N2/1P2QPPP/R1B2RK1 b - - 1 11
+4rrk1/pp1n1pp1/q5p1/P1pP4/2n5/7P/1P3NPN/R2Q1RK1 w - - 3 22
+r4qk1/6r1/1p4p1/2ppBbN1/1p5Q/P7/2P3PP/5RK1 w - - 2 24
+3q2k1/pb3p1p/4pbp1/2r5/PpN2N2/1P2P2P/5PP1/Q2R2K1 b - - 4 26
+8/7p/5k2/5p2/p1p2P2/Pr1pPK2/1P1R3P/8 b - - 2 47
+6k1/6p1/P6p/r1N5/5p2/7P/1b3PP1/4R1K1 w - - 0 37
+8/3p3B/5p2/5P2/p7/PP5k/P2Q2P1/6K1 w - - 4 68
+1r4k1/4ppb1/2n1b1qp/pB4p1/1n1BP1P1/7P/2PNQN2/2RNK2R b K - 8 21
+q4rk1/1n1Qbppp/2p5/1p2p3/1p2P3/2P4P/6P1/2B1NRK1 b - - 0 22
+r3k2r/2p2p2/p2p1n2/1p2p3/4P2p/1PP1NP2/PB3P1P/R4RK1 b kq - 0 20
+8/8/8/8/5kp1/P7/8/1K1N4 w - - 0 64
+8/8/3P3k/8/1p6/8/1P6/1K3n2 b - - 1 64
+5k2/7R/4P2p/5K2/p1r2P1p/8/8/8 b - - 0 62
+EOF
+
+score_positions()
+{
+  exe=$1
+  {
+    while read -r fen; do
+      echo "position fen $fen"
+      echo "go depth $depth"
+    done < fast8_positions.txt
+    echo "quit"
+  } | eval "$WINE_PATH $exe" | grep -o "depth $depth .* score cp [0-9-]*" | awk '{print $NF}'
+}
+
+cd ../src
+
+# build both flavours, reference last so src/stockfish is left untouched
+make clean > /dev/null
+make -j2 build ARCH=$ARCH-fast8 > /dev/null
+mv stockfish ../tests/stockfish_fast8
+make clean > /dev/null
+make -j2 build ARCH=$ARCH > /dev/null
+mv stockfish ../tests/stockfish_ref
+
+cd ../tests
+
+score_positions ./stockfish_ref   > fast8_ref.txt
+score_positions ./stockfish_fast8 > fast8_new.txt
+
+# both builds must score all positions, with multithreading off both runs
+# are deterministic
+[ "$(wc -l < fast8_ref.txt)" = "$(wc -l < fast8_positions.txt)" ]
+[ "$(wc -l < fast8_new.txt)" = "$(wc -l < fast8_positions.txt)" ]
+
+paste fast8_ref.txt fast8_new.txt | awk '
+{
+  x += $1; y += $2; xx += $1 * $1; yy += $2 * $2; xy += $1 * $2
+  mad += ($1 > $2 ? $1 - $2 : $2 - $1); n++
+}
+END {
+  r = (n * xy - x * y) / (sqrt(n * xx - x * x) * sqrt(n * yy - y * y))
+  printf "fast8 report: positions %d, score correlation %.4f, mean abs deviation %.1f cp\n", n, r, mad / n
+  exit !(r >= 0.99)
+}'
+
+rm fast8_positions.txt fast8_ref.txt fast8_new.txt stockfish_ref stockfish_fast8
+
+echo "fast8 testing OK"